@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MurphysLaw.h"
+#include "MurphysLawAroundTargetGenerator.h"
+#include "MurphysLawEnemyContext.h"
+
+UMurphysLawAroundTargetGenerator::UMurphysLawAroundTargetGenerator(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	Center = UMurphysLawEnemyContext::StaticClass();
+	MinRadius = 500.f;
+	MaxRadius = 1500.f;
+	NumberOfRings = 2;
+	PointsPerRing = 12;
+}
+
+// Generates the points around each location of the center context
+void UMurphysLawAroundTargetGenerator::GenerateItems(FEnvQueryInstance& QueryInstance) const
+{
+	TArray<FVector> CenterLocations;
+	QueryInstance.PrepareContext(Center, CenterLocations);
+
+	TArray<FNavLocation> Points;
+	Points.Reserve(CenterLocations.Num() * NumberOfRings * PointsPerRing);
+
+	const float AngleStep = 2.f * PI / PointsPerRing;
+	for (const FVector& CenterLocation : CenterLocations)
+	{
+		for (int32 Ring = 0; Ring < NumberOfRings; ++Ring)
+		{
+			const float Radius = NumberOfRings > 1 ? FMath::Lerp(MinRadius, MaxRadius, static_cast<float>(Ring) / (NumberOfRings - 1)) : MinRadius;
+
+			// Every other ring is shifted by half a step so the points don't line up
+			const float AngleOffset = (Ring % 2) * AngleStep * 0.5f;
+			for (int32 Point = 0; Point < PointsPerRing; ++Point)
+			{
+				const float Angle = AngleOffset + Point * AngleStep;
+				Points.Add(FNavLocation(CenterLocation + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.f) * Radius));
+			}
+		}
+	}
+
+	// Only the points on the navmesh can be reached
+	ProjectAndFilterNavPoints(Points, QueryInstance);
+	StoreNavPoints(Points, QueryInstance);
+}
+
+// Description that will appear in the query editor
+FText UMurphysLawAroundTargetGenerator::GetDescriptionTitle() const
+{
+	return FText::FromString(FString::Printf(TEXT("%d rings of %d points around %s"), NumberOfRings, PointsPerRing, *UEnvQueryTypes::DescribeContext(Center).ToString()));
+}
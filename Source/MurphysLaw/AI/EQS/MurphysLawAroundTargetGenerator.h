@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "EnvironmentQuery/Generators/EnvQueryGenerator_ProjectedPoints.h"
+#include "MurphysLawAroundTargetGenerator.generated.h"
+
+/**
+ * Generates points on rings around the context, projected on the navmesh so only reachable points are kept.
+ */
+UCLASS(meta = (DisplayName = "Points: Around Target"))
+class MURPHYSLAW_API UMurphysLawAroundTargetGenerator : public UEnvQueryGenerator_ProjectedPoints
+{
+	GENERATED_BODY()
+
+	/** Around what the points are generated */
+	UPROPERTY(EditDefaultsOnly, Category = "Generator")
+	TSubclassOf<class UEnvQueryContext> Center;
+
+	/** Radius of the innermost ring */
+	UPROPERTY(EditDefaultsOnly, Category = "Generator")
+	float MinRadius;
+
+	/** Radius of the outermost ring */
+	UPROPERTY(EditDefaultsOnly, Category = "Generator")
+	float MaxRadius;
+
+	/** Number of rings between the min and max radius */
+	UPROPERTY(EditDefaultsOnly, Category = "Generator", meta = (ClampMin = "1"))
+	int32 NumberOfRings;
+
+	/** Number of points on each ring */
+	UPROPERTY(EditDefaultsOnly, Category = "Generator", meta = (ClampMin = "1"))
+	int32 PointsPerRing;
+
+public:
+	UMurphysLawAroundTargetGenerator(const FObjectInitializer& ObjectInitializer);
+
+	/** Generates the points around each location of the center context */
+	void GenerateItems(FEnvQueryInstance& QueryInstance) const override;
+
+	/** Description that will appear in the query editor */
+	FText GetDescriptionTitle() const override;
+};
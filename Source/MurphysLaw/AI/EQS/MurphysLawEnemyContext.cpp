@@ -0,0 +1,17 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MurphysLaw.h"
+#include "MurphysLawEnemyContext.h"
+#include <MurphysLaw/AI/MurphysLawAIController.h>
+#include "EnvironmentQuery/Items/EnvQueryItemType_Actor.h"
+
+// Sets the target of the querier's controller as the context
+void UMurphysLawEnemyContext::ProvideContext(FEnvQueryInstance& QueryInstance, FEnvQueryContextData& ContextData) const
+{
+	const APawn* Querier = Cast<APawn>(QueryInstance.Owner.Get());
+	const AMurphysLawAIController* Controller = Querier != nullptr ? Cast<AMurphysLawAIController>(Querier->GetController()) : nullptr;
+	AActor* Target = Controller != nullptr ? Controller->GetBlackboardTarget() : nullptr;
+
+	if (Target != nullptr)
+		UEnvQueryItemType_Actor::SetContextHelper(ContextData, Target);
+}
@@ -0,0 +1,19 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "EnvironmentQuery/EnvQueryContext.h"
+#include "MurphysLawEnemyContext.generated.h"
+
+/**
+ * Provides the target of the querying bot, read from its blackboard.
+ */
+UCLASS()
+class MURPHYSLAW_API UMurphysLawEnemyContext : public UEnvQueryContext
+{
+	GENERATED_BODY()
+
+public:
+	/** Sets the target of the querier's controller as the context */
+	void ProvideContext(FEnvQueryInstance& QueryInstance, FEnvQueryContextData& ContextData) const override;
+};
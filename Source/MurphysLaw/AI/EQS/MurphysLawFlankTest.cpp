@@ -0,0 +1,89 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MurphysLaw.h"
+#include "MurphysLawFlankTest.h"
+#include "MurphysLawEnemyContext.h"
+#include "EnvironmentQuery/Items/EnvQueryItemType_VectorBase.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("EQS flank points traced"), STAT_ML_EQSFlankTraces, STATGROUP_MurphysLaw);
+
+UMurphysLawFlankTest::UMurphysLawFlankTest(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	Cost = EEnvTestCost::High;
+	ValidItemType = UEnvQueryItemType_VectorBase::StaticClass();
+	SetWorkOnFloatValues(true);
+
+	Enemy = UMurphysLawEnemyContext::StaticClass();
+	MinDistance = 300.f;
+	MaxDistance = 2000.f;
+	PreferredDistance = 1000.f;
+	MinScore = 0.1f;
+	EyesHeight = 150.f;
+}
+
+// Scores and filters the points
+void UMurphysLawFlankTest::RunTest(FEnvQueryInstance& QueryInstance) const
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(QueryInstance.Owner.Get());
+
+	TArray<AActor*> Enemies;
+	if (World == nullptr || !QueryInstance.PrepareContext(Enemy, Enemies) || Enemies.Num() == 0 || Enemies[0] == nullptr) return;
+
+	const AActor* EnemyActor = Enemies[0];
+	FVector EnemyEyes;
+	FRotator EnemyRotation;
+	EnemyActor->GetActorEyesViewPoint(EnemyEyes, EnemyRotation);
+	const FVector EnemyForward = EnemyActor->GetActorForwardVector().GetSafeNormal2D();
+
+	static const FName TraceTag(TEXT("MurphysLawFlankTest"));
+	FCollisionQueryParams Params(TraceTag, true, EnemyActor);
+	Params.AddIgnoredActor(Cast<AActor>(QueryInstance.Owner.Get()));
+
+	const float MinDistanceSquared = FMath::Square(MinDistance);
+	const float MaxDistanceSquared = FMath::Square(MaxDistance);
+	const float DistanceRange = FMath::Max(MaxDistance - MinDistance, 1.f);
+
+	for (FEnvQueryInstance::ItemIterator It(this, QueryInstance); It; ++It)
+	{
+		const FVector ItemLocation = GetItemLocation(QueryInstance, It.GetIndex());
+		const FVector ToItem = ItemLocation - EnemyActor->GetActorLocation();
+
+		// Out of range, nothing else is computed
+		const float DistanceSquared = ToItem.SizeSquared2D();
+		if (DistanceSquared < MinDistanceSquared || DistanceSquared > MaxDistanceSquared)
+		{
+			It.ForceItemState(EEnvItemStatus::Failed);
+			continue;
+		}
+
+		// 1 at the preferred distance, 0 at the ends of the range
+		const float DistanceScore = 1.f - FMath::Abs(FMath::Sqrt(DistanceSquared) - PreferredDistance) / DistanceRange;
+
+		// 1 behind the enemy, 0.5 on its sides and 0 in front of it
+		const float FlankScore = (1.f - FVector::DotProduct(EnemyForward, ToItem.GetSafeNormal2D())) * 0.5f;
+
+		const float Score = FMath::Clamp(DistanceScore * FlankScore, 0.f, 1.f);
+		if (Score < MinScore)
+		{
+			It.ForceItemState(EEnvItemStatus::Failed);
+			continue;
+		}
+
+		// The bot has to be able to shoot from there
+		INC_DWORD_STAT(STAT_ML_EQSFlankTraces);
+		if (World->LineTraceTestByChannel(ItemLocation + FVector(0.f, 0.f, EyesHeight), EnemyEyes, ECC_Visibility, Params))
+		{
+			It.ForceItemState(EEnvItemStatus::Failed);
+			continue;
+		}
+
+		It.SetScore(TestPurpose, FilterType, Score, 0.f, 1.f);
+	}
+}
+
+// Description that will appear in the query editor
+FText UMurphysLawFlankTest::GetDescriptionTitle() const
+{
+	return FText::FromString(FString::Printf(TEXT("Flank %s between %.0f and %.0f"), *UEnvQueryTypes::DescribeContext(Enemy).ToString(), MinDistance, MaxDistance));
+}
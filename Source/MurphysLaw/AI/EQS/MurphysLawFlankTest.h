@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "EnvironmentQuery/EnvQueryTest.h"
+#include "MurphysLawFlankTest.generated.h"
+
+/**
+ * Scores the points from where a bot can shoot at its enemy from the side or the back.
+ *
+ * The checks go from the cheapest to the most expensive: the points out of the distance range are
+ * rejected first, then the points scoring too low, and only the remaining points are traced to the enemy.
+ */
+UCLASS(meta = (DisplayName = "Flank Enemy"))
+class MURPHYSLAW_API UMurphysLawFlankTest : public UEnvQueryTest
+{
+	GENERATED_BODY()
+
+	/** The enemy to flank */
+	UPROPERTY(EditDefaultsOnly, Category = "Flank")
+	TSubclassOf<class UEnvQueryContext> Enemy;
+
+	/** Points closer to the enemy are rejected */
+	UPROPERTY(EditDefaultsOnly, Category = "Flank")
+	float MinDistance;
+
+	/** Points further from the enemy are rejected */
+	UPROPERTY(EditDefaultsOnly, Category = "Flank")
+	float MaxDistance;
+
+	/** Distance to the enemy scoring the best */
+	UPROPERTY(EditDefaultsOnly, Category = "Flank")
+	float PreferredDistance;
+
+	/** Points scoring less are rejected before being traced */
+	UPROPERTY(EditDefaultsOnly, Category = "Flank", meta = (ClampMin = "0", ClampMax = "1"))
+	float MinScore;
+
+	/** Height above the point from where the enemy has to be visible */
+	UPROPERTY(EditDefaultsOnly, Category = "Flank")
+	float EyesHeight;
+
+public:
+	UMurphysLawFlankTest(const FObjectInitializer& ObjectInitializer);
+
+	/** Scores and filters the points */
+	void RunTest(FEnvQueryInstance& QueryInstance) const override;
+
+	/** Description that will appear in the query editor */
+	FText GetDescriptionTitle() const override;
+};
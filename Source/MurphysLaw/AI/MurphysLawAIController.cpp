@@ -8,9 +8,15 @@
 #include <MurphysLaw/Utils/MurphysLawUtils.h>
 #include <MurphysLaw/Character/MurphysLawCharacter.h>
 #include <MurphysLaw/AI/MurphysLawAINavigationPoint.h>
+#include <MurphysLaw/AI/MurphysLawAIScheduler.h>
+#include <MurphysLaw/AI/MurphysLawPatrolPathCache.h>
+#include <MurphysLaw/AI/MurphysLawBotBrain.h>
 
 #include "BehaviorTree/BehaviorTree.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
 
 #include "Perception/AIPerceptionComponent.h"
 #include "Perception/AISenseConfig_Sight.h"
@@ -20,6 +26,14 @@
 #include "GameFramework/Actor.h"
 #include "Navigation/CrowdFollowingComponent.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("AI perception updates"), STAT_ML_AIPerceptionUpdates, STATGROUP_MurphysLaw);
+
+static TAutoConsoleVariable<int32> CVarAICrowd(
+	TEXT("MurphysLaw.AI.Crowd"),
+	0,
+	TEXT("Moves the bots with the detour crowd avoidance instead of letting them path independently.\n")
+	TEXT("Read when a bot begins play."));
+
 // Define constants.
 // NAME MUST ABSOLUTELY MATCH THE BLACKBOARD ASSET DEFINED IN BLUEPRINT !!
 const FName AMurphysLawAIController::KEYNAME_SELFACTOR("SelfActor");
@@ -27,10 +41,13 @@ const FName AMurphysLawAIController::KEYNAME_CANMOVE("CanMove");
 const FName AMurphysLawAIController::KEYNAME_DESTINATION("Destination");
 const FName AMurphysLawAIController::KEYNAME_TARGET("Target");
 
+const float AMurphysLawAIController::CROWD_COLLISION_QUERY_RANGE(600.f);
+const float AMurphysLawAIController::CROWD_SEPARATION_WEIGHT(2.f);
+
 
 AMurphysLawAIController::AMurphysLawAIController()
-	// Enable navigation within crowds
-	//: Super(FObjectInitializer::Get().SetDefaultSubobjectClass<UCrowdFollowingComponent>(TEXT("PathFollowingComponent")))
+	// Enable navigation within crowds, the crowd simulation itself is turned on with MurphysLaw.AI.Crowd
+	: Super(FObjectInitializer::Get().SetDefaultSubobjectClass<UCrowdFollowingComponent>(TEXT("PathFollowingComponent")))
 {
 	bWantsPlayerState = true;
 	// bAllowStrafe = true; // ?? Run and shoot
@@ -40,13 +57,20 @@ AMurphysLawAIController::AMurphysLawAIController()
 
 	// No pawn is yet controlled
 	bPossessPawn = false;
+	MoveStartTime = 0.f;
+
+	KeyIdSelfActor = FBlackboard::InvalidKey;
+	KeyIdCanMove = FBlackboard::InvalidKey;
+	KeyIdDestination = FBlackboard::InvalidKey;
+	KeyIdTarget = FBlackboard::InvalidKey;
 
 	// Create and configure sight sense
+	// Only the enemies are detected, the teams come from the player states through IGenericTeamAgentInterface
 	UAISenseConfig_Sight* SightSenseConfig = CreateDefaultSubobject<UAISenseConfig_Sight>("Sight sense");
 	SightSenseConfig->PeripheralVisionAngleDegrees = 90.f;
 	SightSenseConfig->DetectionByAffiliation.bDetectEnemies = true;
-	SightSenseConfig->DetectionByAffiliation.bDetectNeutrals = true;
-	SightSenseConfig->DetectionByAffiliation.bDetectFriendlies = true;
+	SightSenseConfig->DetectionByAffiliation.bDetectNeutrals = false;
+	SightSenseConfig->DetectionByAffiliation.bDetectFriendlies = false;
 	SightSenseConfig->SightRadius = 100.f * 20.f;
 	SightSenseConfig->LoseSightRadius = SightSenseConfig->SightRadius * 1.2f;
 	SightSenseConfig->AutoSuccessRangeFromLastSeenLocation = SightSenseConfig->SightRadius * 1.1f;
@@ -56,8 +80,8 @@ AMurphysLawAIController::AMurphysLawAIController()
 	HearingSenseConfig->LoSHearingRange = 100.f * 150.f;
 	HearingSenseConfig->bUseLoSHearing = true;
 	HearingSenseConfig->DetectionByAffiliation.bDetectEnemies = true;
-	HearingSenseConfig->DetectionByAffiliation.bDetectNeutrals = true;
-	HearingSenseConfig->DetectionByAffiliation.bDetectFriendlies = true;
+	HearingSenseConfig->DetectionByAffiliation.bDetectNeutrals = false;
+	HearingSenseConfig->DetectionByAffiliation.bDetectFriendlies = false;
 
 	// Create perceptions system
 	UAIPerceptionComponent* Perceptions = CreateDefaultSubobject<UAIPerceptionComponent>("PerceptionComp");
@@ -75,12 +99,18 @@ void AMurphysLawAIController::BeginPlay()
 	// Detect navigation points for patrol state
 	NavigationPoints = MurphysLawUtils::GetAllSceneReferences<AMurphysLawAINavigationPoint>(this);
 
+	ConfigureCrowdFollowing(CVarAICrowd.GetValueOnGameThread() != 0);
+
 	// Bind events callbacks
 	if(GetPerceptionComponent())
 	{
 		GetPerceptionComponent()->OnTargetPerceptionUpdated.AddDynamic(this, &AMurphysLawAIController::OnTargetPerceptionUpdated);
 	}
 
+	// The behavior tree is updated by the scheduler of the server, at a rate depending on the players around
+	MurphysLawAIScheduler* Scheduler = MurphysLawAIScheduler::Get(GetWorld());
+	if (Scheduler != nullptr) Scheduler->Register(this);
+
 	// Make sure the ressource is assigned
 	if (BehaviorTreeAsset == nullptr) ShowError("No behavior tree assigned to AI controller");
 	else if (BehaviorTreeAsset->BlackboardAsset == nullptr) ShowError("No blackboard assigned to AI controller's behavior tree");
@@ -90,6 +120,9 @@ void AMurphysLawAIController::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
+	MurphysLawAIScheduler* Scheduler = MurphysLawAIScheduler::Get(GetWorld());
+	if (Scheduler != nullptr) Scheduler->Unregister(this);
+
 	// Remove bindings
 	if (GetPerceptionComponent())
 	{
@@ -101,6 +134,10 @@ void AMurphysLawAIController::Possess(APawn* InPawn)
 {
 	Super::Possess(InPawn);
 
+	// The team may have been set before the perception was registered
+	AMurphysLawPlayerState* MurphysLawPlayerState = Cast<AMurphysLawPlayerState>(PlayerState);
+	if (MurphysLawPlayerState != nullptr) SetGenericTeamId(MurphysLawPlayerState->GetGenericTeamId());
+
 	// Reset the blackboard and start ai action logic
 	if (BehaviorTreeAsset != nullptr && InPawn != nullptr)
 	{
@@ -132,10 +169,60 @@ void AMurphysLawAIController::UnPossess()
 	if (BrainComponent && BrainComponent->IsRunning()) BrainComponent->StopLogic(StopReason);
 }
 
+// Lets the bot avoid the others through the detour crowd or path independently
+void AMurphysLawAIController::ConfigureCrowdFollowing(const bool UseCrowd)
+{
+	UCrowdFollowingComponent* CrowdFollowing = Cast<UCrowdFollowingComponent>(GetPathFollowingComponent());
+	if (CrowdFollowing == nullptr) return;
+
+	CrowdFollowing->SetCrowdSimulation(UseCrowd);
+	if (!UseCrowd) return;
+
+	// Enough to go through choke points without the cost of the best quality with many bots around
+	CrowdFollowing->SetCrowdAvoidanceQuality(ECrowdAvoidanceQuality::Medium);
+	CrowdFollowing->SetCrowdCollisionQueryRange(CROWD_COLLISION_QUERY_RANGE);
+	CrowdFollowing->SetCrowdSeparation(true);
+	CrowdFollowing->SetCrowdSeparationWeight(CROWD_SEPARATION_WEIGHT);
+}
+
+// Keeps the time the move started to measure the time to destination
+FAIRequestID AMurphysLawAIController::RequestMove(const FAIMoveRequest& MoveRequest, FNavPathSharedPtr Path)
+{
+	MoveStartTime = GetWorld()->GetTimeSeconds();
+	return Super::RequestMove(MoveRequest, Path);
+}
+
+// Measures the time to destination of the moves that succeeded
+void AMurphysLawAIController::OnMoveCompleted(FAIRequestID RequestID, EPathFollowingResult::Type Result)
+{
+	Super::OnMoveCompleted(RequestID, Result);
+
+	if (Result != EPathFollowingResult::Success) return;
+
+	// The moves are counted for the match, the crowd mode is only read when the bots begin play
+	AMurphysLawGameMode* GameMode = Cast<AMurphysLawGameMode>(GetWorld()->GetAuthGameMode());
+	if (GameMode != nullptr) GameMode->RecordBotMoveCompleted(GetWorld()->GetTimeSeconds() - MoveStartTime);
+}
+
+// Changes the team of the bot and lets its perception know
+void AMurphysLawAIController::SetGenericTeamId(const FGenericTeamId& NewTeamID)
+{
+	Super::SetGenericTeamId(NewTeamID);
+
+	// The perception system keeps a copy of the team of its listeners
+	if (GetPerceptionComponent()) GetPerceptionComponent()->RequestStimuliListenerUpdate();
+}
+
 void AMurphysLawAIController::InitializeBlackboardKeys(APawn* InPawn)
 {
 	AMurphysLawCharacter* Character = CastChecked<AMurphysLawCharacter>(InPawn);
 
+	// The keys never change for a blackboard asset
+	KeyIdSelfActor = Blackboard->GetKeyID(KEYNAME_SELFACTOR);
+	KeyIdCanMove = Blackboard->GetKeyID(KEYNAME_CANMOVE);
+	KeyIdDestination = Blackboard->GetKeyID(KEYNAME_DESTINATION);
+	KeyIdTarget = Blackboard->GetKeyID(KEYNAME_TARGET);
+
 	// Save controller pawn
 	SetBlackboardSelfActor(Character);
 	SetBlackboardCanMove(false);
@@ -145,9 +232,15 @@ void AMurphysLawAIController::InitializeBlackboardKeys(APawn* InPawn)
 
 void AMurphysLawAIController::OnTargetPerceptionUpdated(AActor* UpdatedActor, FAIStimulus Stimulus)
 {
+	INC_DWORD_STAT(STAT_ML_AIPerceptionUpdates);
+
+	// The brain keeps the target until it dies, switching on every perception update would fight it
+	if (MurphysLawBotBrain::IsEnabled()) return;
+
 	// Don't handle events if no pawn is controlled
 	if (bPossessPawn && UpdatedActor != GetPawn())
 	{
+		// The perception only reports enemies, this only guards against a team changed since the stimulus
 		if(!MurphysLawUtils::IsInSameTeam(GetPawn(), UpdatedActor))
 		{
 			AMurphysLawCharacter* UpdatedCharacter = CastChecked<AMurphysLawCharacter>(UpdatedActor);
@@ -196,20 +289,52 @@ void AMurphysLawAIController::Respawn()
 }
 
 
-AMurphysLawCharacter* AMurphysLawAIController::GetBlackboardSelfActor() const { return Cast<AMurphysLawCharacter>(Blackboard->GetValueAsObject(KEYNAME_SELFACTOR)); }
-void AMurphysLawAIController::SetBlackboardSelfActor(AMurphysLawCharacter* Self) { Blackboard->SetValueAsObject(KEYNAME_SELFACTOR, Self); }
+AMurphysLawCharacter* AMurphysLawAIController::GetBlackboardSelfActor() const { return Cast<AMurphysLawCharacter>(Blackboard->GetValue<UBlackboardKeyType_Object>(KeyIdSelfActor)); }
+void AMurphysLawAIController::SetBlackboardSelfActor(AMurphysLawCharacter* Self) { Blackboard->SetValue<UBlackboardKeyType_Object>(KeyIdSelfActor, Self); }
 
-bool AMurphysLawAIController::GetBlackboardCanMove() const { return Blackboard->GetValueAsBool(KEYNAME_CANMOVE); }
-void AMurphysLawAIController::SetBlackboardCanMove(const bool CanMove) { Blackboard->SetValueAsBool(KEYNAME_CANMOVE, CanMove); }
+bool AMurphysLawAIController::GetBlackboardCanMove() const { return Blackboard->GetValue<UBlackboardKeyType_Bool>(KeyIdCanMove); }
+void AMurphysLawAIController::SetBlackboardCanMove(const bool CanMove) { Blackboard->SetValue<UBlackboardKeyType_Bool>(KeyIdCanMove, CanMove); }
 
-FVector AMurphysLawAIController::GetBlackboardDestination() const { return Blackboard->GetValueAsVector(KEYNAME_DESTINATION); }
-void AMurphysLawAIController::SetBlackboardDestination(const FVector Destination) { Blackboard->SetValueAsVector(KEYNAME_DESTINATION, Destination); }
+FVector AMurphysLawAIController::GetBlackboardDestination() const { return Blackboard->GetValue<UBlackboardKeyType_Vector>(KeyIdDestination); }
+void AMurphysLawAIController::SetBlackboardDestination(const FVector Destination) { Blackboard->SetValue<UBlackboardKeyType_Vector>(KeyIdDestination, Destination); }
 
-AActor* AMurphysLawAIController::GetBlackboardTarget() const { return Cast<AActor>(Blackboard->GetValueAsObject(KEYNAME_TARGET)); }
-void AMurphysLawAIController::SetBlackboardTarget(AActor* Target) { Blackboard->SetValueAsObject(KEYNAME_TARGET, Target); }
+AActor* AMurphysLawAIController::GetBlackboardTarget() const { return Cast<AActor>(Blackboard->GetValue<UBlackboardKeyType_Object>(KeyIdTarget)); }
+void AMurphysLawAIController::SetBlackboardTarget(AActor* Target) { Blackboard->SetValue<UBlackboardKeyType_Object>(KeyIdTarget, Target); }
 
+// Chooses the next point to patrol to, by path cost when the bot is at a navigation point
 AMurphysLawAINavigationPoint* AMurphysLawAIController::GetPatrolPoint()
 {
 	checkf(NavigationPoints.Num() > 0, TEXT("No navigation points detected"));
+
+	PatrolPath.Reset();
+
+	MurphysLawPatrolPathCache* PatrolPathCache = MurphysLawPatrolPathCache::Get(GetWorld());
+	if (PatrolPathCache != nullptr && GetPawn() != nullptr)
+	{
+		// The paths are found when the match is waiting to start
+		if (!PatrolPathCache->HasBeenBuilt()) PatrolPathCache->Build(GetWorld());
+
+		const int32 CurrentPoint = PatrolPathCache->FindNavigationPoint(GetPawn()->GetActorLocation());
+		AMurphysLawAINavigationPoint* NextPoint = PatrolPathCache->ChooseNextPoint(CurrentPoint, PatrolPath);
+		if (NextPoint != nullptr) return NextPoint;
+	}
+
 	return NavigationPoints[FMath::RandRange(0, NavigationPoints.Num() - 1)];
 }
+
+// Moves along the stored path to the patrol point if the destination is the one chosen last, reports if it did
+bool AMurphysLawAIController::MoveAlongPatrolPath(const FVector& Destination, float AcceptanceRadius)
+{
+	if (!PatrolPath.IsValid() || !PatrolPath->IsValid() || !PatrolPath->IsUpToDate()) return false;
+	// The end of the path is on the navmesh, below the navigation points placed above the floor
+	if ((PatrolPath->GetEndLocation() - Destination).SizeSquared2D() > FMath::Square(AcceptanceRadius + 1.f)) return false;
+
+	// Each move gets its own copy, the path following observes and updates the path it follows
+	const FNavMeshPath* CachedPath = PatrolPath->CastPath<FNavMeshPath>();
+	FNavPathSharedPtr Path = CachedPath != nullptr ? MakeShareable(new FNavMeshPath(*CachedPath)) : PatrolPath;
+	PatrolPath.Reset();
+
+	FAIMoveRequest MoveRequest(Destination);
+	MoveRequest.SetAcceptanceRadius(AcceptanceRadius);
+	return RequestMove(MoveRequest, Path).IsValid();
+}
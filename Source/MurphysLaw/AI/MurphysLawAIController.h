@@ -5,6 +5,7 @@
 #include "Perception/AIPerceptionTypes.h"
 #include "DetourCrowdAIController.h"
 #include "AIController.h"
+#include "BehaviorTree/BehaviorTreeTypes.h"
 #include <MurphysLaw/Interface/MurphysLawIController.h>
 #include "MurphysLawAIController.generated.h"
 
@@ -23,6 +24,12 @@ class MURPHYSLAW_API AMurphysLawAIController : public AAIController, public IMur
 	static const FName KEYNAME_DESTINATION;
 	static const FName KEYNAME_TARGET;
 
+	/** Distance at which the other agents are avoided in crowd mode */
+	static const float CROWD_COLLISION_QUERY_RANGE;
+
+	/** How strongly the bots keep apart in crowd mode */
+	static const float CROWD_SEPARATION_WEIGHT;
+
 	// The logic of Ai actions (set in subclass)
 	UPROPERTY(EditDefaultsOnly, Category = "AI Blackboard")
 	class UBehaviorTree* BehaviorTreeAsset;
@@ -47,6 +54,15 @@ public:
 	virtual void Possess(APawn* InPawn) override;
 	virtual void UnPossess() override;
 
+	/** Keeps the time the move started to measure the time to destination */
+	virtual FAIRequestID RequestMove(const FAIMoveRequest& MoveRequest, FNavPathSharedPtr Path) override;
+
+	/** Measures the time to destination of the moves that succeeded */
+	virtual void OnMoveCompleted(FAIRequestID RequestID, EPathFollowingResult::Type Result) override;
+
+	/** Changes the team of the bot and lets its perception know */
+	virtual void SetGenericTeamId(const FGenericTeamId& NewTeamID) override;
+
 	// Event when controlled pawn has died
 	void OnKilled(const float TimeToRespawn) override;
 	void Respawn() override;
@@ -76,9 +92,28 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "AI Blackboard")
 	void SetBlackboardTarget(class AActor* Self);
 
+	/** Chooses the next point to patrol to, by path cost when the bot is at a navigation point */
 	class AMurphysLawAINavigationPoint* GetPatrolPoint();
 
+	/** Moves along the stored path to the patrol point if the destination is the one chosen last, reports if it did */
+	bool MoveAlongPatrolPath(const FVector& Destination, float AcceptanceRadius);
+
 private:
+	/** The blackboard keys, resolved once when the behavior tree starts instead of by name on each access */
+	FBlackboard::FKey KeyIdSelfActor;
+	FBlackboard::FKey KeyIdCanMove;
+	FBlackboard::FKey KeyIdDestination;
+	FBlackboard::FKey KeyIdTarget;
+
+	/** Stored path to the patrol point chosen last, null when the bot has to find its path */
+	FNavPathSharedPtr PatrolPath;
+
+	/** Time the current move was requested */
+	float MoveStartTime;
+
+	/** Lets the bot avoid the others through the detour crowd or path independently */
+	void ConfigureCrowdFollowing(const bool UseCrowd);
+
 	/** Handle for efficient management of the Respawn timer */
 	FTimerHandle TimerHandle_Respawn;
 };
@@ -0,0 +1,205 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MurphysLaw.h"
+#include "MurphysLawAIScheduler.h"
+#include "MurphysLawAIController.h"
+#include "../Network/MurphysLawGameMode.h"
+#include "BrainComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("AI scheduler"), STAT_ML_AIScheduler, STATGROUP_MurphysLaw);
+DECLARE_CYCLE_STAT(TEXT("AI behavior tree ticks"), STAT_ML_AIBehaviorTreeTicks, STATGROUP_MurphysLaw);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AI bots updated"), STAT_ML_AIBotsUpdated, STATGROUP_MurphysLaw);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AI budget exhausted"), STAT_ML_AIBudgetExhausted, STATGROUP_MurphysLaw);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("AI bots near"), STAT_ML_AIBotsNear, STATGROUP_MurphysLaw);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("AI bots middle"), STAT_ML_AIBotsMiddle, STATGROUP_MurphysLaw);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("AI bots far"), STAT_ML_AIBotsFar, STATGROUP_MurphysLaw);
+
+static TAutoConsoleVariable<int32> CVarAIScheduler(
+	TEXT("MurphysLaw.AI.Scheduler"),
+	1,
+	TEXT("Updates the behavior trees of the bots under a per-frame budget, with a frequency depending on their distance to the players."));
+
+static TAutoConsoleVariable<float> CVarAIBudget(
+	TEXT("MurphysLaw.AI.BudgetMs"),
+	2.f,
+	TEXT("Milliseconds per frame given to the behavior trees of the bots."));
+
+static TAutoConsoleVariable<float> CVarAINearDistance(
+	TEXT("MurphysLaw.AI.NearDistance"),
+	3000.f,
+	TEXT("Distance to a player under which a bot is updated at the near interval."));
+
+static TAutoConsoleVariable<float> CVarAIFarDistance(
+	TEXT("MurphysLaw.AI.FarDistance"),
+	8000.f,
+	TEXT("Distance to every player above which a bot is updated at the far interval."));
+
+static TAutoConsoleVariable<float> CVarAINearInterval(
+	TEXT("MurphysLaw.AI.NearInterval"),
+	0.f,
+	TEXT("Seconds between two updates of a bot near a player or having a target, 0 for every frame."));
+
+static TAutoConsoleVariable<float> CVarAIMiddleInterval(
+	TEXT("MurphysLaw.AI.MiddleInterval"),
+	0.1f,
+	TEXT("Seconds between two updates of a bot between the near and far distances."));
+
+static TAutoConsoleVariable<float> CVarAIFarInterval(
+	TEXT("MurphysLaw.AI.FarInterval"),
+	0.5f,
+	TEXT("Seconds between two updates of a bot far from every player."));
+
+const float MurphysLawAIScheduler::TIER_REFRESH_INTERVAL(0.5f);
+
+MurphysLawAIScheduler::MurphysLawAIScheduler()
+	: NextBot(0), TierRefreshTime(-TIER_REFRESH_INTERVAL)
+{}
+
+// Lets the scheduler update the behavior tree of the bot
+void MurphysLawAIScheduler::Register(AMurphysLawAIController* Controller)
+{
+	if (Bots.ContainsByPredicate([Controller](const Bot& Other) { return Other.Controller == Controller; })) return;
+
+	Bot& NewBot = Bots[Bots.AddDefaulted()];
+	NewBot.Controller = Controller;
+	NewBot.LevelOfDetail = Tier::Near;
+	NewBot.LastUpdateTime = Controller->GetWorld()->GetTimeSeconds();
+}
+
+// Gives the bot back its own tick
+void MurphysLawAIScheduler::Unregister(AMurphysLawAIController* Controller)
+{
+	Bots.RemoveAll([Controller](const Bot& Other) { return Other.Controller == Controller; });
+	SetBrainTickEnabled(Controller, true);
+}
+
+// Updates the due bots until the budget of the frame is spent
+void MurphysLawAIScheduler::Tick(UWorld* World)
+{
+	if (Bots.Num() == 0) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_ML_AIScheduler);
+
+	const bool Enabled = IsEnabled();
+	const float Time = World->GetTimeSeconds();
+	if (Enabled && Time - TierRefreshTime >= TIER_REFRESH_INTERVAL)
+	{
+		TierRefreshTime = Time;
+		RefreshTiers(World);
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double Budget = CVarAIBudget.GetValueOnGameThread() / 1000.0;
+
+	// Starts where the last frame stopped, so every bot gets its turn
+	const int32 NumberOfBots = Bots.Num();
+	int32 Visited = 0;
+	for (; Visited < NumberOfBots; ++Visited)
+	{
+		const int32 Index = (NextBot + Visited) % NumberOfBots;
+		Bot& ScheduledBot = Bots[Index];
+
+		AMurphysLawAIController* Controller = ScheduledBot.Controller.Get();
+		if (Controller == nullptr || Controller->GetBrainComponent() == nullptr) continue;
+
+		// The scheduler can be turned off while the game runs, the behavior tree then ticks on its own every frame
+		SetBrainTickEnabled(Controller, !Enabled);
+		if (!Enabled)
+		{
+			// Once turned back on, the first update only covers the time since the last frame
+			ScheduledBot.LastUpdateTime = Time;
+			continue;
+		}
+
+		if (Time - ScheduledBot.LastUpdateTime < GetInterval(ScheduledBot.LevelOfDetail)) continue;
+
+		if (FPlatformTime::Seconds() - StartTime > Budget)
+		{
+			INC_DWORD_STAT(STAT_ML_AIBudgetExhausted);
+			break;
+		}
+
+		// The behavior tree and its services see the time elapsed since their last update
+		// Divided by the bots updated, the ticks give the cost of a behavior tree per bot
+		SCOPE_CYCLE_COUNTER(STAT_ML_AIBehaviorTreeTicks);
+		Controller->GetBrainComponent()->TickComponent(Time - ScheduledBot.LastUpdateTime, LEVELTICK_All, nullptr);
+		ScheduledBot.LastUpdateTime = Time;
+		INC_DWORD_STAT(STAT_ML_AIBotsUpdated);
+	}
+	NextBot = (NextBot + Visited) % NumberOfBots;
+
+	Bots.RemoveAll([](const Bot& Other) { return !Other.Controller.IsValid(); });
+	if (NextBot >= Bots.Num()) NextBot = 0;
+}
+
+// Reports the scheduler of the game mode, null on clients
+MurphysLawAIScheduler* MurphysLawAIScheduler::Get(const UWorld* World)
+{
+	AMurphysLawGameMode* GameMode = World != nullptr ? Cast<AMurphysLawGameMode>(World->GetAuthGameMode()) : nullptr;
+	return GameMode != nullptr ? &GameMode->GetAIScheduler() : nullptr;
+}
+
+// Indicates if the behavior trees are updated by the scheduler instead of ticking on their own
+bool MurphysLawAIScheduler::IsEnabled()
+{
+	return CVarAIScheduler.GetValueOnGameThread() != 0;
+}
+
+// Computes the level of detail of every bot
+void MurphysLawAIScheduler::RefreshTiers(UWorld* World)
+{
+	HumanLocations.Reset();
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APawn* Pawn = (*It)->GetPawn();
+		if (Pawn != nullptr) HumanLocations.Add(Pawn->GetActorLocation());
+	}
+
+	const float NearDistanceSquared = FMath::Square(CVarAINearDistance.GetValueOnGameThread());
+	const float FarDistanceSquared = FMath::Square(CVarAIFarDistance.GetValueOnGameThread());
+	int32 TierCounts[3] = { 0, 0, 0 };
+
+	for (Bot& ScheduledBot : Bots)
+	{
+		const AMurphysLawAIController* Controller = ScheduledBot.Controller.Get();
+		const APawn* Pawn = Controller != nullptr ? Controller->GetPawn() : nullptr;
+		if (Pawn == nullptr) continue;
+
+		float ClosestDistanceSquared = MAX_FLT;
+		for (const FVector& Location : HumanLocations)
+			ClosestDistanceSquared = FMath::Min(ClosestDistanceSquared, FVector::DistSquared(Location, Pawn->GetActorLocation()));
+
+		// A bot in a fight is always updated as if a player was watching
+		if (ClosestDistanceSquared <= NearDistanceSquared || Controller->GetBlackboardTarget() != nullptr)
+			ScheduledBot.LevelOfDetail = Tier::Near;
+		else if (ClosestDistanceSquared <= FarDistanceSquared)
+			ScheduledBot.LevelOfDetail = Tier::Middle;
+		else
+			ScheduledBot.LevelOfDetail = Tier::Far;
+
+		++TierCounts[static_cast<uint8>(ScheduledBot.LevelOfDetail)];
+	}
+
+	SET_DWORD_STAT(STAT_ML_AIBotsNear, TierCounts[static_cast<uint8>(Tier::Near)]);
+	SET_DWORD_STAT(STAT_ML_AIBotsMiddle, TierCounts[static_cast<uint8>(Tier::Middle)]);
+	SET_DWORD_STAT(STAT_ML_AIBotsFar, TierCounts[static_cast<uint8>(Tier::Far)]);
+}
+
+// Reports the update interval of a level of detail
+float MurphysLawAIScheduler::GetInterval(Tier LevelOfDetail)
+{
+	switch (LevelOfDetail)
+	{
+	case Tier::Near: return CVarAINearInterval.GetValueOnGameThread();
+	case Tier::Middle: return CVarAIMiddleInterval.GetValueOnGameThread();
+	default: return CVarAIFarInterval.GetValueOnGameThread();
+	}
+}
+
+// Lets the behavior tree of the bot tick on its own or not
+void MurphysLawAIScheduler::SetBrainTickEnabled(AMurphysLawAIController* Controller, bool Enabled)
+{
+	UBrainComponent* Brain = Controller != nullptr ? Controller->GetBrainComponent() : nullptr;
+	if (Brain != nullptr && Brain->IsComponentTickEnabled() != Enabled)
+		Brain->SetComponentTickEnabled(Enabled);
+}
@@ -0,0 +1,77 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+/**
+ * Server side scheduler of the bots' behavior trees, and of the services they run, under a per-frame budget.
+ *
+ * Each bot gets an update interval from its level of detail: the bots near a human player or
+ * fighting are updated every frame, the bots at a middle distance a few times per second and the
+ * far away patrollers rarely. The due bots are updated in a round robin until the budget of the frame
+ * is spent, the others are updated first the next frame, so the AI cost stays flat as bots are added.
+ *
+ * The budget, the distances and the intervals are set with the MurphysLaw.AI.* console variables.
+ */
+class MURPHYSLAW_API MurphysLawAIScheduler
+{
+public:
+	/** Level of detail of a bot */
+	enum class Tier : uint8
+	{
+		Near,
+		Middle,
+		Far
+	};
+
+private:
+	/** Number of seconds between two computations of the levels of detail */
+	static const float TIER_REFRESH_INTERVAL;
+
+	/** A bot whose behavior tree is updated by the scheduler */
+	struct Bot
+	{
+		TWeakObjectPtr<class AMurphysLawAIController> Controller;
+		Tier LevelOfDetail;
+		float LastUpdateTime;
+	};
+
+	/** The scheduled bots */
+	TArray<Bot> Bots;
+
+	/** The bot to update first the next frame */
+	int32 NextBot;
+
+	/** Time of the last computation of the levels of detail */
+	float TierRefreshTime;
+
+	/** The locations of the human players, kept from one computation to the other */
+	TArray<FVector> HumanLocations;
+
+public:
+	MurphysLawAIScheduler();
+
+	/** Lets the scheduler update the behavior tree of the bot */
+	void Register(class AMurphysLawAIController* Controller);
+
+	/** Gives the bot back its own tick */
+	void Unregister(class AMurphysLawAIController* Controller);
+
+	/** Updates the due bots until the budget of the frame is spent */
+	void Tick(UWorld* World);
+
+	/** Reports the scheduler of the game mode, null on clients */
+	static MurphysLawAIScheduler* Get(const UWorld* World);
+
+	/** Indicates if the behavior trees are updated by the scheduler instead of ticking on their own */
+	static bool IsEnabled();
+
+private:
+	/** Computes the level of detail of every bot */
+	void RefreshTiers(UWorld* World);
+
+	/** Reports the update interval of a level of detail */
+	static float GetInterval(Tier LevelOfDetail);
+
+	/** Lets the behavior tree of the bot tick on its own or not */
+	static void SetBrainTickEnabled(class AMurphysLawAIController* Controller, bool Enabled);
+};
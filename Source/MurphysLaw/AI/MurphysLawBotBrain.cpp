@@ -0,0 +1,212 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MurphysLaw.h"
+#include "MurphysLawBotBrain.h"
+#include "MurphysLawAIController.h"
+#include "MurphysLawLineOfSightQueries.h"
+#include "../Network/MurphysLawGameMode.h"
+#include "../Network/MurphysLawPlayerState.h"
+#include "../Character/MurphysLawCharacter.h"
+#include "Perception/AIPerceptionComponent.h"
+#include "Async/ParallelFor.h"
+
+DECLARE_CYCLE_STAT(TEXT("Bot brain snapshot"), STAT_ML_BotBrainSnapshot, STATGROUP_MurphysLaw);
+DECLARE_CYCLE_STAT(TEXT("Bot brain decisions"), STAT_ML_BotBrainDecisions, STATGROUP_MurphysLaw);
+DECLARE_CYCLE_STAT(TEXT("Bot brain apply"), STAT_ML_BotBrainApply, STATGROUP_MurphysLaw);
+
+static TAutoConsoleVariable<int32> CVarAIBrain(
+	TEXT("MurphysLaw.AI.Brain"),
+	0,
+	TEXT("Decides the targets and the shots of all the bots in one pass spread on the worker threads,\n")
+	TEXT("instead of in the shoot service of each behavior tree."));
+
+const int32 MurphysLawBotBrain::MIN_PARALLEL_BOTS(16);
+const float MurphysLawBotBrain::FIRE_INTERVAL(0.4f);
+const float MurphysLawBotBrain::FIRE_RANDOM_DEVIATION(1.f);
+
+MurphysLawBotBrain::MurphysLawBotBrain()
+{}
+
+// Decides the target and the shots of every bot, then applies them
+void MurphysLawBotBrain::Tick(UWorld* World)
+{
+	if (!IsEnabled()) return;
+
+	Snapshot(World);
+	if (Bots.Num() == 0) return;
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ML_BotBrainDecisions);
+
+		// Spreading a few bots on the workers costs more than it saves
+		ParallelFor(Bots.Num(), [this](int32 Bot) { Decide(Bot); }, Bots.Num() < MIN_PARALLEL_BOTS);
+	}
+
+	Apply(World);
+}
+
+// Reports the brain of the game mode, null on clients
+MurphysLawBotBrain* MurphysLawBotBrain::Get(const UWorld* World)
+{
+	AMurphysLawGameMode* GameMode = World != nullptr ? Cast<AMurphysLawGameMode>(World->GetAuthGameMode()) : nullptr;
+	return GameMode != nullptr ? &GameMode->GetBotBrain() : nullptr;
+}
+
+// Indicates if the targets and the shots of the bots are decided by the brain
+bool MurphysLawBotBrain::IsEnabled()
+{
+	return CVarAIBrain.GetValueOnGameThread() != 0;
+}
+
+// Copies the characters and the bots in the arrays
+void MurphysLawBotBrain::Snapshot(UWorld* World)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ML_BotBrainSnapshot);
+
+	// Keep the allocated arrays from one frame to the other
+	Characters.Reset();
+	CharacterLocations.Reset();
+	CharacterTeams.Reset();
+	CharacterAlive.Reset();
+	CharacterIndices.Reset();
+
+	for (TActorIterator<AMurphysLawCharacter> It(World); It; ++It)
+	{
+		const AMurphysLawPlayerState* PlayerState = Cast<AMurphysLawPlayerState>(It->PlayerState);
+
+		CharacterIndices.Add(*It, Characters.Num());
+		Characters.Add(*It);
+		CharacterLocations.Add(It->GetActorLocation());
+		CharacterTeams.Add(PlayerState != nullptr ? PlayerState->GetTeam() : INDEX_NONE);
+		CharacterAlive.Add(!It->IsDead());
+	}
+
+	Bots.Reset();
+	BotCharacters.Reset();
+	BotCurrentTargets.Reset();
+	BotHasLineOfSight.Reset();
+	BotCanFire.Reset();
+	BotPerceivedStarts.Reset();
+	BotPerceivedCounts.Reset();
+	PerceivedCharacters.Reset();
+
+	MurphysLawLineOfSightQueries* LineOfSightQueries = MurphysLawLineOfSightQueries::Get(World);
+	const float Time = World->GetTimeSeconds();
+	TArray<AActor*> HostileActors;
+
+	for (TActorIterator<AMurphysLawAIController> It(World); It; ++It)
+	{
+		AMurphysLawAIController* Controller = *It;
+		AMurphysLawCharacter* Self = Cast<AMurphysLawCharacter>(Controller->GetPawn());
+		const int32 SelfIndex = FindCharacter(Self);
+		if (SelfIndex == INDEX_NONE || Controller->GetBlackboardComponent() == nullptr) continue;
+
+		AActor* Target = Controller->GetBlackboardTarget();
+
+		// The line of sight is only known once the shared trace is back, until then the bot holds its fire
+		bool HasLineOfSight = false;
+		if (Target != nullptr && LineOfSightQueries != nullptr)
+			LineOfSightQueries->Query(Self, Target, Time, HasLineOfSight);
+		else if (Target != nullptr)
+			HasLineOfSight = Controller->LineOfSightTo(Target, FVector::ZeroVector, true);
+
+		const float* NextFireTime = NextFireTimes.Find(Controller);
+
+		Bots.Add(Controller);
+		BotCharacters.Add(SelfIndex);
+		BotCurrentTargets.Add(FindCharacter(Target));
+		BotHasLineOfSight.Add(HasLineOfSight);
+		BotCanFire.Add(Self->HasWeaponEquipped() && (NextFireTime == nullptr || Time >= *NextFireTime));
+
+		HostileActors.Reset();
+		if (Controller->GetPerceptionComponent() != nullptr)
+			Controller->GetPerceptionComponent()->GetHostileActors(HostileActors);
+
+		BotPerceivedStarts.Add(PerceivedCharacters.Num());
+		for (const AActor* Actor : HostileActors)
+		{
+			const int32 Index = FindCharacter(Actor);
+			if (Index != INDEX_NONE) PerceivedCharacters.Add(Index);
+		}
+		BotPerceivedCounts.Add(PerceivedCharacters.Num() - BotPerceivedStarts.Last());
+	}
+
+	BotNewTargets.SetNumUninitialized(Bots.Num());
+	BotWantsFire.SetNumUninitialized(Bots.Num());
+}
+
+// Decides the target and the shot of a bot from the arrays only, called from the worker threads
+void MurphysLawBotBrain::Decide(int32 Bot)
+{
+	const int32 Self = BotCharacters[Bot];
+	const int32 CurrentTarget = BotCurrentTargets[Bot];
+	const FVector& SelfLocation = CharacterLocations[Self];
+
+	// As with the perception events, a bot keeps its enemy until it dies or changes team
+	const bool IsCurrentTargetValid = CurrentTarget != INDEX_NONE && CharacterAlive[CurrentTarget]
+		&& CharacterTeams[CurrentTarget] != CharacterTeams[Self];
+
+	int32 NewTarget = IsCurrentTargetValid ? CurrentTarget : INDEX_NONE;
+	if (NewTarget == INDEX_NONE)
+	{
+		float ClosestDistanceSquared = MAX_FLT;
+		const int32 End = BotPerceivedStarts[Bot] + BotPerceivedCounts[Bot];
+		for (int32 It = BotPerceivedStarts[Bot]; It < End; ++It)
+		{
+			const int32 Candidate = PerceivedCharacters[It];
+			if (!CharacterAlive[Candidate] || CharacterTeams[Candidate] == CharacterTeams[Self]) continue;
+
+			const float DistanceSquared = FVector::DistSquared(SelfLocation, CharacterLocations[Candidate]);
+			if (DistanceSquared < ClosestDistanceSquared)
+			{
+				ClosestDistanceSquared = DistanceSquared;
+				NewTarget = Candidate;
+			}
+		}
+	}
+
+	BotNewTargets[Bot] = NewTarget;
+
+	// The line of sight was traced to the current target, a new target waits for its own trace
+	BotWantsFire[Bot] = NewTarget != INDEX_NONE && NewTarget == CurrentTarget && BotHasLineOfSight[Bot] && BotCanFire[Bot];
+}
+
+// Applies the decisions to the blackboards and the characters
+void MurphysLawBotBrain::Apply(UWorld* World)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ML_BotBrainApply);
+
+	const float Time = World->GetTimeSeconds();
+
+	for (int32 Bot = 0; Bot < Bots.Num(); ++Bot)
+	{
+		AMurphysLawAIController* Controller = Bots[Bot];
+		const int32 NewTarget = BotNewTargets[Bot];
+
+		if (NewTarget != BotCurrentTargets[Bot])
+		{
+			AMurphysLawCharacter* Target = NewTarget != INDEX_NONE ? Characters[NewTarget] : nullptr;
+			if (Target != nullptr) Controller->SetFocus(Target->GetFocalPoint(), EAIFocusPriority::Gameplay);
+			else Controller->ClearFocus(EAIFocusPriority::Gameplay);
+			Controller->SetBlackboardTarget(Target);
+		}
+
+		if (BotWantsFire[Bot])
+		{
+			Characters[BotCharacters[Bot]]->Fire();
+			NextFireTimes.Add(Controller, Time + FIRE_INTERVAL + FMath::FRand() * FIRE_RANDOM_DEVIATION);
+		}
+	}
+
+	for (auto It = NextFireTimes.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid()) It.RemoveCurrent();
+	}
+}
+
+// Reports the index of the character, INDEX_NONE if unknown
+int32 MurphysLawBotBrain::FindCharacter(const AActor* Actor) const
+{
+	const int32* Index = Actor != nullptr ? CharacterIndices.Find(Actor) : nullptr;
+	return Index != nullptr ? *Index : INDEX_NONE;
+}
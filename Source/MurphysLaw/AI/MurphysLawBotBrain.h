@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+/**
+ * Server side pass deciding the target and the shots of every bot at once.
+ *
+ * The characters and the bots are copied in flat arrays on the game thread, the decisions
+ * are computed on the worker threads from those arrays only, then applied to the blackboards
+ * and the characters on the game thread. A bot keeps its target while it is alive, otherwise it
+ * takes the closest perceived enemy, and it fires at the shooting interval of the shoot service
+ * when the shared line of sight query reports that its target is visible.
+ *
+ * Enabled with MurphysLaw.AI.Brain, the shoot service then leaves the shots to the brain
+ * and the perception of the controller leaves the targets to it.
+ */
+class MURPHYSLAW_API MurphysLawBotBrain
+{
+	/** Number of bots under which the decisions are computed on the game thread */
+	static const int32 MIN_PARALLEL_BOTS;
+
+	/** Minimum number of seconds between two shots, as the interval of the shoot service */
+	static const float FIRE_INTERVAL;
+
+	/** Maximum number of seconds added to the interval, as the random deviation of the shoot service */
+	static const float FIRE_RANDOM_DEVIATION;
+
+	/** The characters, indexed the same in each array */
+	TArray<class AMurphysLawCharacter*> Characters;
+	TArray<FVector> CharacterLocations;
+	TArray<int32> CharacterTeams;
+	TArray<bool> CharacterAlive;
+
+	/** The bots, indexed the same in each array */
+	TArray<class AMurphysLawAIController*> Bots;
+	TArray<int32> BotCharacters;
+	TArray<int32> BotCurrentTargets;
+	TArray<bool> BotHasLineOfSight;
+	TArray<bool> BotCanFire;
+
+	/** Range of PerceivedCharacters perceived by each bot */
+	TArray<int32> BotPerceivedStarts;
+	TArray<int32> BotPerceivedCounts;
+
+	/** The characters perceived by the bots, one range per bot */
+	TArray<int32> PerceivedCharacters;
+
+	/** The decisions of each bot */
+	TArray<int32> BotNewTargets;
+	TArray<bool> BotWantsFire;
+
+	/** Index of each character in the character arrays */
+	TMap<const class AActor*, int32> CharacterIndices;
+
+	/** Time of the next shot of each bot */
+	TMap<TWeakObjectPtr<class AMurphysLawAIController>, float> NextFireTimes;
+
+public:
+	MurphysLawBotBrain();
+
+	/** Decides the target and the shots of every bot, then applies them */
+	void Tick(UWorld* World);
+
+	/** Reports the brain of the game mode, null on clients */
+	static MurphysLawBotBrain* Get(const UWorld* World);
+
+	/** Indicates if the targets and the shots of the bots are decided by the brain */
+	static bool IsEnabled();
+
+private:
+	/** Copies the characters and the bots in the arrays */
+	void Snapshot(UWorld* World);
+
+	/** Decides the target and the shot of a bot from the arrays only, called from the worker threads */
+	void Decide(int32 Bot);
+
+	/** Applies the decisions to the blackboards and the characters */
+	void Apply(UWorld* World);
+
+	/** Reports the index of the character, INDEX_NONE if unknown */
+	int32 FindCharacter(const class AActor* Actor) const;
+};
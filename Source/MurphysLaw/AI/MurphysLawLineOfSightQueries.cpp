@@ -0,0 +1,133 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MurphysLaw.h"
+#include "MurphysLawLineOfSightQueries.h"
+#include "../Network/MurphysLawGameMode.h"
+
+DECLARE_CYCLE_STAT(TEXT("Line of sight batch"), STAT_ML_LineOfSightBatch, STATGROUP_MurphysLaw);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Line of sight queries"), STAT_ML_LineOfSightQueries, STATGROUP_MurphysLaw);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Line of sight cached results"), STAT_ML_LineOfSightCacheHits, STATGROUP_MurphysLaw);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Line of sight traces"), STAT_ML_LineOfSightTraces, STATGROUP_MurphysLaw);
+
+const float MurphysLawLineOfSightQueries::RESULT_TIME_TO_LIVE(0.25f);
+const uint64 MurphysLawLineOfSightQueries::MAX_PENDING_FRAMES(2);
+
+MurphysLawLineOfSightQueries::Pair::Pair(const AActor* A, const AActor* B)
+	: First(A < B ? A : B), Second(A < B ? B : A)
+{}
+
+// Reports if the result for the pair is known and still fresh, requests a trace otherwise
+bool MurphysLawLineOfSightQueries::Query(const AActor* Viewer, const AActor* Target, float Time, bool& OutHasLineOfSight)
+{
+	INC_DWORD_STAT(STAT_ML_LineOfSightQueries);
+
+	const Pair Key(Viewer, Target);
+	Entry* PairEntry = Entries.Find(Key);
+	if (PairEntry == nullptr)
+	{
+		PairEntry = &Entries.Add(Key);
+		PairEntry->First = Key.First;
+		PairEntry->Second = Key.Second;
+		PairEntry->HasLineOfSight = false;
+		PairEntry->HasResult = false;
+		PairEntry->ResultTime = 0.f;
+		PairEntry->IsPending = false;
+		PairEntry->TraceFrame = 0;
+	}
+
+	if (PairEntry->HasResult && Time - PairEntry->ResultTime <= RESULT_TIME_TO_LIVE)
+	{
+		INC_DWORD_STAT(STAT_ML_LineOfSightCacheHits);
+		OutHasLineOfSight = PairEntry->HasLineOfSight;
+		return true;
+	}
+
+	// Whoever asked first, the pair is only traced once
+	if (!PairEntry->IsPending)
+	{
+		PairEntry->IsPending = true;
+		PairEntry->Trace = FTraceHandle();
+		Requests.Add(Key);
+	}
+	return false;
+}
+
+// Reads the results of the previous batch, issues the requested traces and forgets the old pairs
+void MurphysLawLineOfSightQueries::Tick(UWorld* World)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ML_LineOfSightBatch);
+
+	const float Time = World->GetTimeSeconds();
+
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		Entry& PairEntry = It.Value();
+
+		// One of the actors is gone or nobody asked for the pair in a while
+		if (!PairEntry.First.IsValid() || !PairEntry.Second.IsValid()
+			|| (!PairEntry.IsPending && Time - PairEntry.ResultTime > RESULT_TIME_TO_LIVE * 4.f))
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (PairEntry.IsPending && PairEntry.Trace.IsValid())
+			ReadResult(World, PairEntry, Time);
+	}
+
+	static const FName TraceTag(TEXT("MurphysLawLineOfSight"));
+
+	for (const Pair& Key : Requests)
+	{
+		Entry* PairEntry = Entries.Find(Key);
+		if (PairEntry == nullptr || !PairEntry->IsPending || PairEntry->Trace.IsValid()) continue;
+
+		const AActor* First = PairEntry->First.Get();
+		const AActor* Second = PairEntry->Second.Get();
+
+		FCollisionQueryParams Params(TraceTag, true, First);
+		Params.AddIgnoredActor(Second);
+
+		// From eyes to eyes, the same ray whichever of the two asked
+		PairEntry->Trace = World->AsyncLineTraceByChannel(GetEyesLocation(First), GetEyesLocation(Second), ECC_Visibility, Params);
+		PairEntry->TraceFrame = GFrameCounter;
+		INC_DWORD_STAT(STAT_ML_LineOfSightTraces);
+	}
+	Requests.Reset();
+}
+
+// Reports the queries of the game mode, null on clients
+MurphysLawLineOfSightQueries* MurphysLawLineOfSightQueries::Get(const UWorld* World)
+{
+	AMurphysLawGameMode* GameMode = World != nullptr ? Cast<AMurphysLawGameMode>(World->GetAuthGameMode()) : nullptr;
+	return GameMode != nullptr ? &GameMode->GetLineOfSightQueries() : nullptr;
+}
+
+// Reports where an actor sees from
+FVector MurphysLawLineOfSightQueries::GetEyesLocation(const AActor* Actor)
+{
+	FVector EyesLocation;
+	FRotator EyesRotation;
+	Actor->GetActorEyesViewPoint(EyesLocation, EyesRotation);
+	return EyesLocation;
+}
+
+// Reads the result of a running trace
+void MurphysLawLineOfSightQueries::ReadResult(UWorld* World, Entry& PairEntry, float Time) const
+{
+	FTraceDatum Result;
+	if (World->QueryTraceData(PairEntry.Trace, Result))
+	{
+		PairEntry.HasLineOfSight = !Result.OutHits.ContainsByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+		PairEntry.HasResult = true;
+		PairEntry.ResultTime = Time;
+		PairEntry.IsPending = false;
+		PairEntry.Trace = FTraceHandle();
+	}
+	else if (GFrameCounter - PairEntry.TraceFrame > MAX_PENDING_FRAMES)
+	{
+		// The result was lost, the pair is traced again the next time it is asked for
+		PairEntry.IsPending = false;
+		PairEntry.Trace = FTraceHandle();
+	}
+}
@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+/**
+ * Server side line of sight queries shared by all the bots.
+ *
+ * The bots ask for the line of sight between them and their target. A pair of actors is traced once,
+ * whichever of the two asks, and the result is cached for a short time. The traces requested during
+ * a frame are issued asynchronously in one batch when the game mode ticks and their results are
+ * read the next frame, so the game thread never waits for a trace.
+ */
+class MURPHYSLAW_API MurphysLawLineOfSightQueries
+{
+	/** Number of seconds a result is reused */
+	static const float RESULT_TIME_TO_LIVE;
+
+	/** Number of frames after which a trace that did not come back is requested again */
+	static const uint64 MAX_PENDING_FRAMES;
+
+	/** Two actors, in the same order whoever asks */
+	struct Pair
+	{
+		const AActor* First;
+		const AActor* Second;
+
+		Pair(const AActor* A, const AActor* B);
+		bool operator==(const Pair& Other) const { return First == Other.First && Second == Other.Second; }
+		friend uint32 GetTypeHash(const Pair& Key) { return HashCombine(PointerHash(Key.First), PointerHash(Key.Second)); }
+	};
+
+	/** The line of sight between two actors */
+	struct Entry
+	{
+		TWeakObjectPtr<const AActor> First;
+		TWeakObjectPtr<const AActor> Second;
+
+		/** Result of the last trace */
+		bool HasLineOfSight;
+
+		/** Indicates if the result has been traced at least once */
+		bool HasResult;
+
+		/** Time of the last result */
+		float ResultTime;
+
+		/** Indicates if a trace is requested or running */
+		bool IsPending;
+
+		/** Handle of the running trace, invalid when the trace is not issued yet */
+		FTraceHandle Trace;
+
+		/** Frame the trace was issued */
+		uint64 TraceFrame;
+	};
+
+	/** The lines of sight asked for recently */
+	TMap<Pair, Entry> Entries;
+
+	/** The pairs to trace with the next batch */
+	TArray<Pair> Requests;
+
+public:
+	/** Reports if the result for the pair is known and still fresh, requests a trace otherwise */
+	bool Query(const AActor* Viewer, const AActor* Target, float Time, bool& OutHasLineOfSight);
+
+	/** Reads the results of the previous batch, issues the requested traces and forgets the old pairs */
+	void Tick(UWorld* World);
+
+	/** Reports the queries of the game mode, null on clients */
+	static MurphysLawLineOfSightQueries* Get(const UWorld* World);
+
+private:
+	/** Reports where an actor sees from */
+	static FVector GetEyesLocation(const AActor* Actor);
+
+	/** Reads the result of a running trace */
+	void ReadResult(UWorld* World, Entry& PairEntry, float Time) const;
+};
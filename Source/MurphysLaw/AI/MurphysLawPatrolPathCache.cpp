@@ -0,0 +1,203 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MurphysLaw.h"
+#include "MurphysLawPatrolPathCache.h"
+#include "MurphysLawAINavigationPoint.h"
+#include "../Network/MurphysLawGameMode.h"
+#include "AI/Navigation/NavigationSystem.h"
+#include "AI/Navigation/RecastNavMesh.h"
+
+DEFINE_LOG_CATEGORY_STATIC(ML_PatrolPathCache, Log, All);
+
+DECLARE_CYCLE_STAT(TEXT("Patrol path cache build"), STAT_ML_PatrolPathCacheBuild, STATGROUP_MurphysLaw);
+DECLARE_MEMORY_STAT(TEXT("Patrol path cache"), STAT_ML_PatrolPathCacheMemory, STATGROUP_MurphysLaw);
+
+const float MurphysLawPatrolPathCache::NAVIGATION_POINT_TOLERANCE(300.f);
+const int32 MurphysLawPatrolPathCache::MAX_PATHS_REFRESHED_PER_TICK(8);
+
+MurphysLawPatrolPathCache::MurphysLawPatrolPathCache()
+	: IsBuilt(false)
+{}
+
+// Finds the paths between every pair of navigation points
+void MurphysLawPatrolPathCache::Build(UWorld* World)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ML_PatrolPathCacheBuild);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	Points.Reset();
+	Paths.Reset();
+	Costs.Reset();
+	StalePaths.Reset();
+
+	UNavigationSystem* NavigationSystem = UNavigationSystem::GetCurrent<UNavigationSystem>(World);
+	ANavigationData* NavigationData = NavigationSystem != nullptr ? NavigationSystem->GetMainNavData(FNavigationSystem::DontCreate) : nullptr;
+	if (NavigationData == nullptr)
+	{
+		ShowWarning("MurphysLawPatrolPathCache - No navmesh to find the patrol paths on");
+		return;
+	}
+
+	for (TActorIterator<AMurphysLawAINavigationPoint> It(World); It; ++It)
+		Points.Add(*It);
+
+	const int32 NumberOfPoints = Points.Num();
+	Paths.SetNum(NumberOfPoints * NumberOfPoints);
+	Costs.Init(MAX_FLT, NumberOfPoints * NumberOfPoints);
+
+	int32 NumberOfPaths = 0;
+	for (int32 From = 0; From < NumberOfPoints; ++From)
+	{
+		for (int32 To = 0; To < NumberOfPoints; ++To)
+		{
+			if (From != To && FindPath(NavigationSystem, NavigationData, From, To)) ++NumberOfPaths;
+		}
+	}
+
+	IsBuilt = true;
+
+	const SIZE_T AllocatedSize = GetAllocatedSize();
+	SET_MEMORY_STAT(STAT_ML_PatrolPathCacheMemory, AllocatedSize);
+	UE_LOG(ML_PatrolPathCache, Log, TEXT("%d paths between %d navigation points found in %.2f ms, %u bytes"),
+		NumberOfPaths, NumberOfPoints, (FPlatformTime::Seconds() - StartTime) * 1000.0, static_cast<uint32>(AllocatedSize));
+}
+
+// Queues the paths the rebuilt navmesh changed, they are found again over the next frames
+void MurphysLawPatrolPathCache::OnNavigationRebuilt()
+{
+	if (!IsBuilt) return;
+
+	// The navmesh marks the paths crossing its rebuilt tiles as out of date, the unreachable pairs may now be connected
+	StalePaths.Reset();
+	const int32 NumberOfPoints = Points.Num();
+	for (int32 Index = 0; Index < Paths.Num(); ++Index)
+	{
+		if (Index / NumberOfPoints == Index % NumberOfPoints) continue;
+		if (!Paths[Index].IsValid() || !Paths[Index]->IsValid() || !Paths[Index]->IsUpToDate())
+			StalePaths.Add(Index);
+	}
+
+	UE_LOG(ML_PatrolPathCache, Log, TEXT("%d paths to find again after the navmesh was rebuilt"), StalePaths.Num());
+}
+
+// Finds again a few of the paths changed by the navmesh
+void MurphysLawPatrolPathCache::Tick(UWorld* World)
+{
+	if (StalePaths.Num() == 0) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_ML_PatrolPathCacheBuild);
+
+	UNavigationSystem* NavigationSystem = UNavigationSystem::GetCurrent<UNavigationSystem>(World);
+	ANavigationData* NavigationData = NavigationSystem != nullptr ? NavigationSystem->GetMainNavData(FNavigationSystem::DontCreate) : nullptr;
+	if (NavigationData == nullptr) return;
+
+	const int32 NumberOfPoints = Points.Num();
+	for (int32 Refreshed = 0; Refreshed < MAX_PATHS_REFRESHED_PER_TICK && StalePaths.Num() > 0; ++Refreshed)
+	{
+		const int32 Index = StalePaths.Pop(false);
+		Paths[Index].Reset();
+		Costs[Index] = MAX_FLT;
+		if (Points[Index / NumberOfPoints].IsValid() && Points[Index % NumberOfPoints].IsValid())
+			FindPath(NavigationSystem, NavigationData, Index / NumberOfPoints, Index % NumberOfPoints);
+	}
+
+	if (StalePaths.Num() == 0) SET_MEMORY_STAT(STAT_ML_PatrolPathCacheMemory, GetAllocatedSize());
+}
+
+// Indicates if the paths match the current navmesh
+bool MurphysLawPatrolPathCache::HasBeenBuilt() const { return IsBuilt; }
+
+// Reports the navigation point at the location, INDEX_NONE if there is none
+int32 MurphysLawPatrolPathCache::FindNavigationPoint(const FVector& Location) const
+{
+	int32 Closest = INDEX_NONE;
+	float ClosestDistanceSquared = FMath::Square(NAVIGATION_POINT_TOLERANCE);
+	for (int32 i = 0; i < Points.Num(); ++i)
+	{
+		if (!Points[i].IsValid()) continue;
+
+		const float DistanceSquared = FVector::DistSquared(Points[i]->GetActorLocation(), Location);
+		if (DistanceSquared <= ClosestDistanceSquared)
+		{
+			Closest = i;
+			ClosestDistanceSquared = DistanceSquared;
+		}
+	}
+	return Closest;
+}
+
+// Chooses the next point to patrol to, by path cost from the point the bot is at, and the path to it
+AMurphysLawAINavigationPoint* MurphysLawPatrolPathCache::ChooseNextPoint(int32 From, FNavPathSharedPtr& OutPath) const
+{
+	OutPath.Reset();
+
+	const int32 NumberOfPoints = Points.Num();
+	if (NumberOfPoints == 0) return nullptr;
+
+	// Away from the navigation points, the bot goes anywhere and finds its path
+	if (!IsBuilt || From == INDEX_NONE) return Points[FMath::RandRange(0, NumberOfPoints - 1)].Get();
+
+	// The cheaper the path, the more likely the point
+	float TotalWeight = 0.f;
+	for (int32 To = 0; To < NumberOfPoints; ++To)
+	{
+		// The paths waiting to be found again after a navmesh rebuild are skipped
+		const FNavPathSharedPtr& Path = Paths[From * NumberOfPoints + To];
+		if (Path.IsValid() && Path->IsUpToDate() && Points[To].IsValid()) TotalWeight += 1.f / FMath::Max(Costs[From * NumberOfPoints + To], 1.f);
+	}
+	if (TotalWeight <= 0.f) return nullptr;
+
+	float Choice = FMath::FRandRange(0.f, TotalWeight);
+	for (int32 To = 0; To < NumberOfPoints; ++To)
+	{
+		const FNavPathSharedPtr& Path = Paths[From * NumberOfPoints + To];
+		if (!Path.IsValid() || !Path->IsUpToDate() || !Points[To].IsValid()) continue;
+
+		Choice -= 1.f / FMath::Max(Costs[From * NumberOfPoints + To], 1.f);
+		if (Choice <= 0.f)
+		{
+			OutPath = Path;
+			return Points[To].Get();
+		}
+	}
+	return nullptr;
+}
+
+// Reports the cache of the game mode, null on clients
+MurphysLawPatrolPathCache* MurphysLawPatrolPathCache::Get(const UWorld* World)
+{
+	AMurphysLawGameMode* GameMode = World != nullptr ? Cast<AMurphysLawGameMode>(World->GetAuthGameMode()) : nullptr;
+	return GameMode != nullptr ? &GameMode->GetPatrolPathCache() : nullptr;
+}
+
+// Finds the path between two navigation points, returns true if it exists
+bool MurphysLawPatrolPathCache::FindPath(UNavigationSystem* NavigationSystem, ANavigationData* NavigationData, int32 From, int32 To)
+{
+	FPathFindingQuery Query(nullptr, *NavigationData, Points[From]->GetActorLocation(), Points[To]->GetActorLocation(), NavigationData->GetDefaultQueryFilter());
+	const FPathFindingResult Result = NavigationSystem->FindPathSync(Query);
+	if (!Result.IsSuccessful() || !Result.Path.IsValid() || Result.IsPartial()) return false;
+
+	// The navmesh would find the path again as soon as a tile it crosses is rebuilt, the cache spreads that over the frames
+	Result.Path->EnableRecalculationOnInvalidation(false);
+
+	const int32 Index = From * Points.Num() + To;
+	Paths[Index] = Result.Path;
+	Costs[Index] = Result.Path->GetCost() > 0.f ? Result.Path->GetCost() : Result.Path->GetLength();
+	return true;
+}
+
+// Reports the memory used by the paths
+SIZE_T MurphysLawPatrolPathCache::GetAllocatedSize() const
+{
+	SIZE_T AllocatedSize = Points.GetAllocatedSize() + Paths.GetAllocatedSize() + Costs.GetAllocatedSize();
+	for (const FNavPathSharedPtr& Path : Paths)
+	{
+		if (!Path.IsValid()) continue;
+
+		AllocatedSize += sizeof(FNavMeshPath) + Path->GetPathPoints().GetAllocatedSize();
+		if (const FNavMeshPath* MeshPath = Path->CastPath<FNavMeshPath>())
+			AllocatedSize += MeshPath->PathCorridor.GetAllocatedSize() + MeshPath->PathCorridorCost.GetAllocatedSize();
+	}
+	return AllocatedSize;
+}
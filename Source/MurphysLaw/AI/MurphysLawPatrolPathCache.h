@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "AI/Navigation/NavigationData.h"
+
+/**
+ * Navmesh paths between every pair of navigation points, found once when the map is loaded.
+ *
+ * The patrolling bots follow the stored paths instead of asking for a pathfind on each patrol,
+ * and choose their next point by path cost, the closest points being the most likely.
+ * When the navmesh is rebuilt, only the paths crossing the rebuilt tiles and the unreachable pairs
+ * are found again, a few per frame, and the bots do not use them until then.
+ */
+class MURPHYSLAW_API MurphysLawPatrolPathCache
+{
+	/** Distance under which a bot is considered at a navigation point */
+	static const float NAVIGATION_POINT_TOLERANCE;
+
+	/** Number of paths found again each frame after the navmesh was rebuilt */
+	static const int32 MAX_PATHS_REFRESHED_PER_TICK;
+
+	/** The navigation points of the map */
+	TArray<TWeakObjectPtr<class AMurphysLawAINavigationPoint> > Points;
+
+	/** The path from each point to each other point, at From * Points.Num() + To, null when unreachable */
+	TArray<FNavPathSharedPtr> Paths;
+
+	/** The cost of each path */
+	TArray<float> Costs;
+
+	/** The paths to find again since the navmesh was rebuilt, at From * Points.Num() + To */
+	TArray<int32> StalePaths;
+
+	/** Indicates if the paths match the current navmesh */
+	bool IsBuilt;
+
+public:
+	MurphysLawPatrolPathCache();
+
+	/** Finds the paths between every pair of navigation points */
+	void Build(UWorld* World);
+
+	/** Queues the paths the rebuilt navmesh changed, they are found again over the next frames */
+	void OnNavigationRebuilt();
+
+	/** Finds again a few of the paths changed by the navmesh */
+	void Tick(UWorld* World);
+
+	/** Indicates if the paths match the current navmesh */
+	bool HasBeenBuilt() const;
+
+	/** Reports the navigation point at the location, INDEX_NONE if there is none */
+	int32 FindNavigationPoint(const FVector& Location) const;
+
+	/** Chooses the next point to patrol to, by path cost from the point the bot is at, and the path to it */
+	class AMurphysLawAINavigationPoint* ChooseNextPoint(int32 From, FNavPathSharedPtr& OutPath) const;
+
+	/** Reports the cache of the game mode, null on clients */
+	static MurphysLawPatrolPathCache* Get(const UWorld* World);
+
+private:
+	/** Finds the path between two navigation points, returns true if it exists */
+	bool FindPath(class UNavigationSystem* NavigationSystem, ANavigationData* NavigationData, int32 From, int32 To);
+
+	/** Reports the memory used by the paths */
+	SIZE_T GetAllocatedSize() const;
+};
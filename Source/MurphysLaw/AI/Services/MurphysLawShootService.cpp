@@ -6,14 +6,45 @@
 #include <MurphysLaw/AI/MurphysLawAIController.h>
 #include <MurphysLaw/Weapon/MurphysLawBaseWeapon.h>
 #include <MurphysLaw/Character/MurphysLawCharacter.h>
+#include <MurphysLaw/AI/MurphysLawLineOfSightQueries.h>
+#include <MurphysLaw/AI/MurphysLawBotBrain.h>
+#include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
 
+const float UMurphysLawShootService::PENDING_RETRY_INTERVAL(0.05f);
 
 UMurphysLawShootService::UMurphysLawShootService()
 {
 	Interval = 0.4f;			// Defines timespawn between subsequent tick of the service
 	RandomDeviation = 1.f;		// Added amount range to service's interval
 
+	bNotifyBecomeRelevant = true;
+
 	NodeName = "Shoot if LOS";
+
+	// Matches the key of the blackboard used by the bots
+	TargetKey.SelectedKeyName = FName("Target");
+	TargetKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UMurphysLawShootService, TargetKey), AActor::StaticClass());
+}
+
+// Resolves the key of the target once for the behavior tree
+void UMurphysLawShootService::InitializeFromAsset(UBehaviorTree& Asset)
+{
+	Super::InitializeFromAsset(Asset);
+
+	UBlackboardData* BlackboardAsset = GetBlackboardAsset();
+	if (BlackboardAsset != nullptr) TargetKey.ResolveSelectedKey(*BlackboardAsset);
+}
+
+// Keeps the bot in the memory of the node
+void UMurphysLawShootService::OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	Super::OnBecomeRelevant(OwnerComp, NodeMemory);
+
+	ShootMemory* Memory = reinterpret_cast<ShootMemory*>(NodeMemory);
+	Memory->Controller = OwnerComp.GetAIOwner();
+	Memory->Self = Memory->Controller != nullptr ? Cast<AMurphysLawCharacter>(Memory->Controller->GetPawn()) : nullptr;
 }
 
 /** update next tick interval
@@ -21,16 +52,37 @@ UMurphysLawShootService::UMurphysLawShootService()
 void UMurphysLawShootService::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
 {
 	Super::TickNode(OwnerComp, NodeMemory, DeltaSeconds);
-	AMurphysLawAIController* Controller = CastChecked<AMurphysLawAIController>(OwnerComp.GetOwner());
-	
+
+	// The shots of all the bots are decided together
+	if (MurphysLawBotBrain::IsEnabled()) return;
+
+	const ShootMemory* Memory = reinterpret_cast<ShootMemory*>(NodeMemory);
+	const UBlackboardComponent* BlackboardComp = OwnerComp.GetBlackboardComponent();
+	if (Memory->Controller == nullptr || Memory->Self == nullptr || BlackboardComp == nullptr) return;
+
 	// Retreive needed references
-	AActor* Target = Controller->GetBlackboardTarget();
-	AMurphysLawCharacter* Self = Controller->GetBlackboardSelfActor();
+	AActor* Target = Cast<AActor>(BlackboardComp->GetValue<UBlackboardKeyType_Object>(TargetKey.GetSelectedKeyID()));
+	AAIController* Controller = Memory->Controller;
+	AMurphysLawCharacter* Self = Memory->Self;
+
+	if (Target == nullptr) return;
+
+	MurphysLawLineOfSightQueries* LineOfSightQueries = MurphysLawLineOfSightQueries::Get(GetWorld());
+	if (LineOfSightQueries == nullptr)
+	{
+		if (Controller->LineOfSightTo(Target, FVector::ZeroVector, true)) Self->Fire();
+		return;
+	}
 
-	if (Self != nullptr && Target != nullptr && Controller->LineOfSightTo(Target, FVector::ZeroVector, true))
+	// The trace is shared with the target and comes back next frame, so check again shortly
+	bool HasLineOfSight;
+	if (!LineOfSightQueries->Query(Self, Target, GetWorld()->GetTimeSeconds(), HasLineOfSight))
 	{
-		Self->Fire();
+		SetNextTickTime(NodeMemory, PENDING_RETRY_INTERVAL);
+		return;
 	}
+
+	if (HasLineOfSight) Self->Fire();
 }
 
 // Gets the description for our service
@@ -38,3 +90,9 @@ FString UMurphysLawShootService::GetStaticServiceDescription() const
 {
 	return TEXT("Shoot a bullet using equipped gun if there is a line of sight");
 }
+
+// Size of the memory of the service for each bot
+uint16 UMurphysLawShootService::GetInstanceMemorySize() const
+{
+	return sizeof(ShootMemory);
+}
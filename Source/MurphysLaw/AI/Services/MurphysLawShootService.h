@@ -16,11 +16,35 @@ class MURPHYSLAW_API UMurphysLawShootService : public UBTService
 public:
 	UMurphysLawShootService();
 
+	/** Resolves the key of the target once for the behavior tree */
+	void InitializeFromAsset(UBehaviorTree& Asset) override;
+
 protected:
+	/** The actor to shoot at */
+	UPROPERTY(EditAnywhere, Category = "Blackboard")
+	struct FBlackboardKeySelector TargetKey;
+
+	/** Keeps the bot in the memory of the node */
+	void OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+
 	/** update next tick interval
 	* this function should be considered as const (don't modify state of object) if node is not instanced! */
 	virtual void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
 
 	// Gets the description for our service
 	virtual FString GetStaticServiceDescription() const override;
+
+	/** Size of the memory of the service for each bot */
+	uint16 GetInstanceMemorySize() const override;
+
+private:
+	/** The memory of the service for each bot */
+	struct ShootMemory
+	{
+		class AAIController* Controller;
+		class AMurphysLawCharacter* Self;
+	};
+
+	/** Delay before asking again for a line of sight that is being traced */
+	static const float PENDING_RETRY_INTERVAL;
 };
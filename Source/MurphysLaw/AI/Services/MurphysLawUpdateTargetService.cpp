@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MurphysLaw.h"
+#include "MurphysLawUpdateTargetService.h"
+#include <MurphysLaw/Character/MurphysLawCharacter.h>
+#include <MurphysLaw/Utils/MurphysLawUtils.h>
+#include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "AIController.h"
+
+UMurphysLawUpdateTargetService::UMurphysLawUpdateTargetService()
+{
+	bNotifyBecomeRelevant = true;
+	Interval = 0.25f;
+	RandomDeviation = 0.05f;
+
+	NodeName = "Update target";
+
+	// Matches the key of the blackboard used by the bots
+	TargetKey.SelectedKeyName = FName("Target");
+	TargetKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UMurphysLawUpdateTargetService, TargetKey), AActor::StaticClass());
+}
+
+// Resolves the key of the target once for the behavior tree
+void UMurphysLawUpdateTargetService::InitializeFromAsset(UBehaviorTree& Asset)
+{
+	Super::InitializeFromAsset(Asset);
+
+	UBlackboardData* BlackboardAsset = GetBlackboardAsset();
+	if (BlackboardAsset != nullptr) TargetKey.ResolveSelectedKey(*BlackboardAsset);
+}
+
+// Keeps the bot in the memory of the node
+void UMurphysLawUpdateTargetService::OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	Super::OnBecomeRelevant(OwnerComp, NodeMemory);
+
+	const AAIController* Controller = OwnerComp.GetAIOwner();
+	reinterpret_cast<UpdateTargetMemory*>(NodeMemory)->Self = Controller != nullptr ? Cast<AMurphysLawCharacter>(Controller->GetPawn()) : nullptr;
+}
+
+// Clears the target when it is no longer an enemy
+void UMurphysLawUpdateTargetService::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+{
+	Super::TickNode(OwnerComp, NodeMemory, DeltaSeconds);
+
+	UBlackboardComponent* BlackboardComp = OwnerComp.GetBlackboardComponent();
+	const AMurphysLawCharacter* Self = reinterpret_cast<UpdateTargetMemory*>(NodeMemory)->Self;
+	if (BlackboardComp == nullptr || Self == nullptr) return;
+
+	const AMurphysLawCharacter* Target = Cast<AMurphysLawCharacter>(BlackboardComp->GetValue<UBlackboardKeyType_Object>(TargetKey.GetSelectedKeyID()));
+	if (Target != nullptr && (Target->IsDead() || MurphysLawUtils::IsInSameTeam(Self, Target)))
+		BlackboardComp->SetValue<UBlackboardKeyType_Object>(TargetKey.GetSelectedKeyID(), nullptr);
+}
+
+// Size of the memory of the service for each bot
+uint16 UMurphysLawUpdateTargetService::GetInstanceMemorySize() const
+{
+	return sizeof(UpdateTargetMemory);
+}
+
+// Gets the description for our service
+FString UMurphysLawUpdateTargetService::GetStaticServiceDescription() const
+{
+	return FString::Printf(TEXT("Clear %s when it is dead or a teammate"), *TargetKey.SelectedKeyName.ToString());
+}
@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "BehaviorTree/BTService.h"
+#include "MurphysLawUpdateTargetService.generated.h"
+
+/**
+ * Forgets the target of the blackboard once it is dead or has joined the team of the bot,
+ * so the bot goes back to patrolling until its perception reports another enemy.
+ */
+UCLASS()
+class MURPHYSLAW_API UMurphysLawUpdateTargetService : public UBTService
+{
+	GENERATED_BODY()
+
+public:
+	UMurphysLawUpdateTargetService();
+
+	/** Resolves the key of the target once for the behavior tree */
+	void InitializeFromAsset(UBehaviorTree& Asset) override;
+
+protected:
+	/** The actor the bot is fighting */
+	UPROPERTY(EditAnywhere, Category = "Blackboard")
+	struct FBlackboardKeySelector TargetKey;
+
+	/** Keeps the bot in the memory of the node */
+	void OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+
+	/** Clears the target when it is no longer an enemy */
+	void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+
+	/** Size of the memory of the service for each bot */
+	uint16 GetInstanceMemorySize() const override;
+
+	// Gets the description for our service
+	FString GetStaticServiceDescription() const override;
+
+private:
+	/** The memory of the service for each bot */
+	struct UpdateTargetMemory
+	{
+		class AMurphysLawCharacter* Self;
+	};
+};
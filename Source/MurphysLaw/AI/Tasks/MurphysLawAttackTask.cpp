@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MurphysLaw.h"
+#include "MurphysLawAttackTask.h"
+#include <MurphysLaw/Character/MurphysLawCharacter.h>
+#include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "AIController.h"
+
+UMurphysLawAttackTask::UMurphysLawAttackTask()
+{
+	NodeName = "Attack";
+
+	// Matches the key of the blackboard used by the bots
+	TargetKey.SelectedKeyName = FName("Target");
+	TargetKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UMurphysLawAttackTask, TargetKey), AActor::StaticClass());
+}
+
+// Resolves the key of the target once for the behavior tree
+void UMurphysLawAttackTask::InitializeFromAsset(UBehaviorTree& Asset)
+{
+	Super::InitializeFromAsset(Asset);
+
+	UBlackboardData* BlackboardAsset = GetBlackboardAsset();
+	if (BlackboardAsset != nullptr) TargetKey.ResolveSelectedKey(*BlackboardAsset);
+}
+
+// Fires at the target, fails when there is none or when the bot is dead
+EBTNodeResult::Type UMurphysLawAttackTask::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	const UBlackboardComponent* BlackboardComp = OwnerComp.GetBlackboardComponent();
+	const AAIController* Controller = OwnerComp.GetAIOwner();
+	AMurphysLawCharacter* Self = Controller != nullptr ? Cast<AMurphysLawCharacter>(Controller->GetPawn()) : nullptr;
+	if (BlackboardComp == nullptr || Self == nullptr || Self->IsDead()) return EBTNodeResult::Failed;
+
+	if (BlackboardComp->GetValue<UBlackboardKeyType_Object>(TargetKey.GetSelectedKeyID()) == nullptr) return EBTNodeResult::Failed;
+
+	Self->Fire();
+	return EBTNodeResult::Succeeded;
+}
+
+/** Description that will appear above node in behavior tree */
+FString UMurphysLawAttackTask::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("Fire at %s"), *TargetKey.SelectedKeyName.ToString());
+}
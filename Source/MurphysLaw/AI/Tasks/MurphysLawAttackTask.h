@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "BehaviorTree/BTTaskNode.h"
+#include "MurphysLawAttackTask.generated.h"
+
+/**
+ * Fires once at the target of the blackboard, replaces the Blueprint attack task.
+ */
+UCLASS()
+class MURPHYSLAW_API UMurphysLawAttackTask : public UBTTaskNode
+{
+	GENERATED_BODY()
+
+public:
+	UMurphysLawAttackTask();
+
+	/** Resolves the key of the target once for the behavior tree */
+	void InitializeFromAsset(UBehaviorTree& Asset) override;
+
+	/** Fires at the target, fails when there is none or when the bot is dead */
+	EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+
+	/** Description that will appear above node in behavior tree */
+	FString GetStaticDescription() const override;
+
+protected:
+	/** The actor to attack */
+	UPROPERTY(EditAnywhere, Category = "Blackboard")
+	struct FBlackboardKeySelector TargetKey;
+};
@@ -2,6 +2,9 @@
 
 #include "MurphysLaw.h"
 #include "MurphysLawMoveToTask.h"
+#include <MurphysLaw/AI/MurphysLawAIController.h>
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
 
 
 
@@ -13,6 +16,15 @@ UMurphysLawMoveToTask::UMurphysLawMoveToTask()
 /* Fonction d'excution de la tche, cette tche devra retourner Succeeded, Failed ou InProgress */
 EBTNodeResult::Type UMurphysLawMoveToTask::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
+	// Patrols reuse the path found when the map was loaded
+	AMurphysLawAIController* Controller = Cast<AMurphysLawAIController>(OwnerComp.GetOwner());
+	const UBlackboardComponent* BlackboardComp = OwnerComp.GetBlackboardComponent();
+	if (Controller != nullptr && BlackboardComp != nullptr && BlackboardKey.SelectedKeyType == UBlackboardKeyType_Vector::StaticClass()
+		&& Controller->MoveAlongPatrolPath(BlackboardComp->GetValue<UBlackboardKeyType_Vector>(BlackboardKey.GetSelectedKeyID()), AcceptableRadius))
+	{
+		return EBTNodeResult::Succeeded;
+	}
+
 	(void) Super::ExecuteTask(OwnerComp, NodeMemory);
 	return EBTNodeResult::Succeeded; // Force success
 }
@@ -5,11 +5,15 @@
 
 #include <MurphysLaw/AI/MurphysLawAIController.h>
 #include <MurphysLaw/Character/MurphysLawCharacter.h>
+#include "EnvironmentQuery/EnvQueryManager.h"
+#include "EnvironmentQuery/EnvQuery.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
 
 
 UMurphysLawSeekTargetTask::UMurphysLawSeekTargetTask()
 {
 	NodeName = "UpdateNextTargetPoint";
+	FlankQuery = nullptr;
 }
 
 /* Fonction d'excution de la tche, cette tche devra retourner Succeeded, Failed ou InProgress */
@@ -22,6 +26,17 @@ EBTNodeResult::Type UMurphysLawSeekTargetTask::ExecuteTask(UBehaviorTreeComponen
 	AActor* Target = Controller->GetBlackboardTarget();
 	AMurphysLawCharacter* Self = Controller->GetBlackboardSelfActor();
 	
+	SeekTargetMemory* Memory = reinterpret_cast<SeekTargetMemory*>(NodeMemory);
+	Memory->RequestID = INDEX_NONE;
+
+	// The query manager runs the query over as many frames as its budget requires
+	if (Target != nullptr && Self != nullptr && FlankQuery != nullptr)
+	{
+		FEnvQueryRequest Request(FlankQuery, Self);
+		Memory->RequestID = Request.Execute(EEnvQueryRunMode::SingleResult, FQueryFinishedSignature::CreateUObject(this, &UMurphysLawSeekTargetTask::OnFlankQueryFinished));
+		if (Memory->RequestID != INDEX_NONE) return EBTNodeResult::InProgress;
+	}
+
 	if(Target != nullptr && Self != nullptr)
 	{
 		const FVector PredictedDestination = PredictTargetDestination(Target, Self);
@@ -36,15 +51,58 @@ EBTNodeResult::Type UMurphysLawSeekTargetTask::ExecuteTask(UBehaviorTreeComponen
 }
 
 // static
-// Will probably end up in EQS query
+// Used when no flank query is set or when the query finds no position
 FVector UMurphysLawSeekTargetTask::PredictTargetDestination(const AActor* Target, const AMurphysLawCharacter* Self)
 {
 	// Compute predicted destination of target
 	return Target->GetActorLocation() + Target->GetVelocity();;
 }
 
+// Stops the running query
+EBTNodeResult::Type UMurphysLawSeekTargetTask::AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	SeekTargetMemory* Memory = reinterpret_cast<SeekTargetMemory*>(NodeMemory);
+	UEnvQueryManager* QueryManager = UEnvQueryManager::GetCurrent(OwnerComp.GetWorld());
+	if (QueryManager != nullptr && Memory->RequestID != INDEX_NONE)
+		QueryManager->AbortQuery(Memory->RequestID);
+
+	Memory->RequestID = INDEX_NONE;
+	return EBTNodeResult::Aborted;
+}
+
+// Size of the memory of the task for each bot
+uint16 UMurphysLawSeekTargetTask::GetInstanceMemorySize() const
+{
+	return sizeof(SeekTargetMemory);
+}
+
+// Called by the query manager when the flank query is done, possibly a few frames later
+void UMurphysLawSeekTargetTask::OnFlankQueryFinished(TSharedPtr<FEnvQueryResult> Result)
+{
+	const APawn* Self = Cast<APawn>(Result->Owner.Get());
+	AMurphysLawAIController* Controller = Self != nullptr ? Cast<AMurphysLawAIController>(Self->GetController()) : nullptr;
+	UBehaviorTreeComponent* OwnerComp = Controller != nullptr ? Cast<UBehaviorTreeComponent>(Controller->GetBrainComponent()) : nullptr;
+	if (OwnerComp == nullptr) return;
+
+	uint8* NodeMemory = OwnerComp->GetNodeMemory(this, OwnerComp->FindInstanceContainingNode(this));
+	if (NodeMemory == nullptr || reinterpret_cast<SeekTargetMemory*>(NodeMemory)->RequestID != Result->QueryID) return;
+	reinterpret_cast<SeekTargetMemory*>(NodeMemory)->RequestID = INDEX_NONE;
+
+	// Without flanking position, the bot goes where the target is going
+	AActor* Target = Controller->GetBlackboardTarget();
+	if (Result->IsSuccsessful() && Result->Items.Num() > 0)
+		Controller->SetBlackboardDestination(Result->GetItemAsLocation(0));
+	else if (Target != nullptr && Controller->GetBlackboardSelfActor() != nullptr)
+		Controller->SetBlackboardDestination(PredictTargetDestination(Target, Controller->GetBlackboardSelfActor()));
+
+	FinishLatentTask(*OwnerComp, Target != nullptr ? EBTNodeResult::Succeeded : EBTNodeResult::Failed);
+}
+
 /** Description that will appear above node in behavior tree */
 FString UMurphysLawSeekTargetTask::GetStaticDescription() const
 {
-	return TEXT("Compute near location to target");
+	// No flank query asset exists yet, the bots go where the target is going until one is assigned here
+	return FlankQuery != nullptr
+		? FString::Printf(TEXT("Compute near location to target\nFlanking with %s"), *FlankQuery->GetName())
+		: TEXT("Compute near location to target\nNo flanking, FlankQuery is not set");
 }
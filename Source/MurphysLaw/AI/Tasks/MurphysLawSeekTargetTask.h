@@ -3,6 +3,7 @@
 #pragma once
 
 #include "BehaviorTree/BTTaskNode.h"
+#include "EnvironmentQuery/EnvQueryTypes.h"
 #include "MurphysLawSeekTargetTask.generated.h"
 
 /**
@@ -19,10 +20,31 @@ public:
 	/* Fonction d'excution de la tche, cette tche devra retourner Succeeded, Failed ou InProgress */
 	EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
 
+	/** Stops the running query */
+	EBTNodeResult::Type AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+
+	/** Size of the memory of the task for each bot */
+	uint16 GetInstanceMemorySize() const override;
+
 	/** Description that will appear above node in behavior tree */
 	FString GetStaticDescription() const override;
 
+protected:
+	/** Query choosing where to go around the target, the target's predicted location is used when not set */
+	UPROPERTY(EditAnywhere, Category = "Seek")
+	class UEnvQuery* FlankQuery;
+
 private:
+	/** The memory of the task for each bot */
+	struct SeekTargetMemory
+	{
+		/** The running query, INDEX_NONE when none */
+		int32 RequestID;
+	};
+
+	/** Called by the query manager when the flank query is done, possibly a few frames later */
+	void OnFlankQueryFinished(TSharedPtr<FEnvQueryResult> Result);
+
 	// Core function of the node; predict target position to move closer
 	static FVector PredictTargetDestination(const class AActor* Target, const class AMurphysLawCharacter* Self);
 };
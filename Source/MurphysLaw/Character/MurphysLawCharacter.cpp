@@ -9,16 +9,18 @@
 #include "../Menu/MurphysLawInGameMenu.h"
 #include "../Network/MurphysLawPlayerController.h"
 #include "../AI/MurphysLawAIController.h"
-#include "WidgetComponent.h"
 #include "Blueprint/UserWidget.h"
 #include "Animation/AnimInstance.h"
 #include "UnrealNetwork.h"
 #include "../DamageZone/MurphysLawDamageZone.h"
 #include "../Environnement/ExplosiveBarrel/MurphysLawExplosiveBarrel.h"
-#include "MurphysLawNameplateWidget.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "../Network/MurphysLawGameMode.h"
 #include "../Network/MurphysLawGameState.h"
+#include "../Network/MurphysLawRelevancyGrid.h"
+#include "../Utils/MurphysLawAssetStreamer.h"
+#include "Perception/AIPerceptionSystem.h"
+#include "Perception/AISense_Sight.h"
 
 #include <MurphysLaw/Interface/MurphysLawIController.h>
 #include <MurphysLaw/Utils/MurphysLawUtils.h>
@@ -37,6 +39,61 @@ const float AMurphysLawCharacter::FACTOR_HEADSHOT(3.f);
 const float AMurphysLawCharacter::FACTOR_CHESTSHOT(1.5f);
 const FString AMurphysLawCharacter::SOCKET_HEAD = "Head";
 const FString AMurphysLawCharacter::SOCKET_SPINE = "Spine1";
+const float AMurphysLawCharacter::STAMINA_CORRECTION_TOLERANCE(10.f);
+
+#pragma region Replicated vitals
+
+FMurphysLawCharacterVitals::FMurphysLawCharacterVitals()
+	: Health(0), Stamina(0), Dead(0), WeaponSlot(NO_WEAPON_SLOT), HasDetails(0)
+{}
+
+// Writes or reads the packed vitals
+bool FMurphysLawCharacterVitals::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	// Dead, weapon slot and details flags fit in 4 bits
+	uint8 Flags = Ar.IsSaving() ? (Dead | (WeaponSlot << 1) | (HasDetails << 3)) : 0;
+	Ar.SerializeBits(&Flags, 4);
+
+	if (Ar.IsLoading())
+	{
+		Dead = Flags & 1;
+		WeaponSlot = (Flags >> 1) & 3;
+		HasDetails = (Flags >> 3) & 1;
+	}
+
+	if (HasDetails)
+	{
+		Ar << Health;
+		Ar << Stamina;
+	}
+
+	bOutSuccess = true;
+	return true;
+}
+
+bool FMurphysLawCharacterVitals::operator==(const FMurphysLawCharacterVitals& Other) const
+{
+	return Health == Other.Health
+		&& Stamina == Other.Stamina
+		&& Dead == Other.Dead
+		&& WeaponSlot == Other.WeaponSlot
+		&& HasDetails == Other.HasDetails;
+}
+
+// Converts a level between zero and its maximum to a byte
+uint8 FMurphysLawCharacterVitals::Quantize(float Value, float MaxValue)
+{
+	if (MaxValue <= 0.f) return 0;
+	return (uint8)FMath::RoundToInt(FMath::Clamp(Value / MaxValue, 0.f, 1.f) * MAX_uint8);
+}
+
+// Converts a byte back to a level between zero and its maximum
+float FMurphysLawCharacterVitals::Dequantize(uint8 Value, float MaxValue)
+{
+	return Value * MaxValue / MAX_uint8;
+}
+
+#pragma endregion
 
 AMurphysLawCharacter::AMurphysLawCharacter()
 {
@@ -61,10 +118,6 @@ AMurphysLawCharacter::AMurphysLawCharacter()
 	SceneComponent->AttachParent = GetCapsuleComponent();
 	SceneComponent->RelativeLocation = FVector(-20, 0, 120);
 
-	// Create a CharacterNameplate	
-	CharacterNameplate = CreateDefaultSubobject<UWidgetComponent>(TEXT("CharacterNameplate"));
-	CharacterNameplate->AttachParent = SceneComponent;
-
 	// Create a mesh component that will be used when being viewed from a '1st person' view (when controlling this pawn)
 	Mesh1P = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("CharacterMesh1P"));
 	Mesh1P->SetOnlyOwnerSee(true);
@@ -105,13 +158,8 @@ AMurphysLawCharacter::AMurphysLawCharacter()
 	// Spawning settings
 	SpawnCollisionHandlingMethod = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
-	// Try to load the sound of switching weapon
-	static ConstructorHelpers::FObjectFinder<USoundBase> SwitchWeaponSound(TEXT("SoundWave'/Game/MurphysLawRessources/Weapons/S_Switch_Weapon.S_Switch_Weapon'"));
-	SwitchingWeaponSound = nullptr;
-	if (SwitchWeaponSound.Succeeded())
-	{
-		SwitchingWeaponSound = SwitchWeaponSound.Object;
-	}
+	// The sound of switching weapon is loaded when the character begins to play
+	SwitchingWeaponSound = FStringAssetReference(TEXT("/Game/MurphysLawRessources/Weapons/S_Switch_Weapon.S_Switch_Weapon"));
 
 	// Sets up the stamina info
 	MaxStamina = 100.f;
@@ -129,13 +177,26 @@ void AMurphysLawCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(AMurphysLawCharacter, CurrentWeaponIndex);
-	DOREPLIFETIME(AMurphysLawCharacter, CurrentHealth);
-	DOREPLIFETIME(AMurphysLawCharacter, Dead);
+	DOREPLIFETIME_CONDITION(AMurphysLawCharacter, OwnerVitals, COND_OwnerOnly);
+	DOREPLIFETIME_CONDITION(AMurphysLawCharacter, PublicVitals, COND_SkipOwner);
 	DOREPLIFETIME(AMurphysLawCharacter, TeamBodyMeshColor);
 	DOREPLIFETIME(AMurphysLawCharacter, TeamMaskMeshColor);
 }
 
+// Uses the relevancy grid of the server to decide if the character is sent to a connection
+bool AMurphysLawCharacter::IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation) const
+{
+	// The viewer always needs its own character
+	if (bAlwaysRelevant || this == ViewTarget || IsOwnedBy(ViewTarget) || IsOwnedBy(RealViewer) || Instigator == ViewTarget)
+		return true;
+
+	MurphysLawRelevancyGrid* RelevancyGrid = MurphysLawRelevancyGrid::Get(GetWorld());
+	if (RelevancyGrid == nullptr || !RelevancyGrid->HasBeenBuilt())
+		return Super::IsNetRelevantFor(RealViewer, ViewTarget, SrcLocation);
+
+	return RelevancyGrid->IsRelevant(this, RealViewer, SrcLocation, GetWorld()->GetTimeSeconds());
+}
+
 void AMurphysLawCharacter::BeginPlay()
 {
 	Super::BeginPlay();
@@ -143,7 +204,12 @@ void AMurphysLawCharacter::BeginPlay()
 	// AI settings ressources
 	if (AIControllerClass == nullptr) ShowWarning("No AIController class assigned to MurphysLawCharacter");
 
-	if (SwitchingWeaponSound == nullptr) ShowWarning("MurphysLawCharacter - Unable to load the SwitchingWeaponSound");
+	if (SwitchingWeaponSound.IsNull()) ShowWarning("MurphysLawCharacter - No SwitchingWeaponSound assigned");
+
+	// A dedicated server plays no sound
+	MurphysLawAssetStreamer* AssetStreamer = MurphysLawAssetStreamer::Get(GetWorld());
+	if (AssetStreamer != nullptr && !SwitchingWeaponSound.IsNull() && GetNetMode() != NM_DedicatedServer)
+		AssetStreamer->RequestAsyncLoad(StaticClass(), TArray<FStringAssetReference>{ SwitchingWeaponSound.ToStringReference() });
 
 	// If the InventoryComponent's BeginPlay has not been called yet, we call it
 	if (!Inventory->HasBegunPlay())
@@ -155,15 +221,15 @@ void AMurphysLawCharacter::BeginPlay()
 
 	// Set the current health of the character here in case the value has been overriden in a subclass
 	CurrentHealth = MaxHealth;
-
-	auto NameplateWidget = Cast<UMurphysLawNameplateWidget>(CharacterNameplate->GetUserWidgetObject());
-	if (NameplateWidget)
-	{
-		NameplateWidget->SetCharacter(this);
-	}
+	PushHealthToHUD();
 
 	// Sets the current stamina level to the maximum
 	CurrentStamina = MaxStamina;
+	PushStaminaToHUD();
+
+	if (Role == ROLE_Authority) UpdateReplicatedVitals();
+
+	NotifyTeamAffiliationChanged();
 }
 
 // Called when game ends
@@ -173,6 +239,8 @@ void AMurphysLawCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 
 	// Clear the inventory
 	if (Inventory->HasBegunPlay()) Inventory->EndPlay(EndPlayReason);
+
+	NotifyTeamAffiliationChanged();
 }
 
 // Called when the character is possessed by a new controller
@@ -186,6 +254,50 @@ void AMurphysLawCharacter::PossessedBy(AController* NewController)
 		const bool ConfigureAsBot = NewController->IsA<AAIController>();
 		ConfigureMovement(ConfigureAsBot);
 	}
+
+	UpdatePerceptionTeam();
+	NotifyTeamAffiliationChanged();
+}
+
+// Called when the character is no longer possessed by its controller
+void AMurphysLawCharacter::UnPossessed()
+{
+	Super::UnPossessed();
+	UpdatePerceptionTeam();
+	NotifyTeamAffiliationChanged();
+}
+
+// Registers the character again with the sight of the bots, which keeps the team a target had when registered
+void AMurphysLawCharacter::UpdatePerceptionTeam()
+{
+	// Only the server has a perception system
+	UAIPerceptionSystem* PerceptionSystem = Role == ROLE_Authority ? UAIPerceptionSystem::GetCurrent(this) : nullptr;
+	if (PerceptionSystem == nullptr) return;
+
+	// The pooled characters were registered without a player state, as NoTeam
+	PerceptionSystem->UnregisterSource(*this, UAISense_Sight::StaticClass());
+	PerceptionSystem->RegisterSource<UAISense_Sight>(*this);
+}
+
+// Executed on the clients when the player state of the character is replicated
+void AMurphysLawCharacter::OnRep_PlayerState()
+{
+	Super::OnRep_PlayerState();
+	NotifyTeamAffiliationChanged();
+}
+
+// Lets the nameplate overlays know that the teammates have to be recomputed
+void AMurphysLawCharacter::NotifyTeamAffiliationChanged() const
+{
+	AMurphysLawGameState* GameState = GetWorld() != nullptr ? GetWorld()->GetGameState<AMurphysLawGameState>() : nullptr;
+	if (GameState != nullptr)
+		GameState->MarkTeamAffiliationChanged();
+}
+
+// Reports where the name of the character is drawn
+FVector AMurphysLawCharacter::GetNameplateLocation() const
+{
+	return SceneComponent->GetComponentLocation();
 }
 
 /** Configure character movement with human or bot specific settings */
@@ -217,6 +329,13 @@ void AMurphysLawCharacter::ConfigureMovement(const bool ConfigureForBot)
 	Since the gun is located in the center of the body, it is a good focal point */
 AActor* AMurphysLawCharacter::GetFocalPoint() const { return GetEquippedWeapon(); }
 
+// Reports the team of the player controlling the character, so the bots only perceive their enemies
+FGenericTeamId AMurphysLawCharacter::GetGenericTeamId() const
+{
+	const AMurphysLawPlayerState* MurphysLawPlayerState = Cast<AMurphysLawPlayerState>(PlayerState);
+	return MurphysLawPlayerState != nullptr ? MurphysLawPlayerState->GetGenericTeamId() : FGenericTeamId::NoTeam;
+}
+
 void AMurphysLawCharacter::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
@@ -292,6 +411,10 @@ void AMurphysLawCharacter::Tick(float DeltaSeconds)
 		HighestZ = 0;
 		SetIsInAir(false);
 	}
+
+	// Unchanged vitals are not sent again
+	if (Role == ROLE_Authority) UpdateReplicatedVitals();
+
 	/** [PS] DO NOT REMOVE - Trying to make it work */
 
 	//ACharacter* myCharacter = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
@@ -391,6 +514,7 @@ void AMurphysLawCharacter::ReceiveHealAmount(const float HealingAmount)
 {
 	checkf(HealingAmount >= 0, TEXT("HealingAmount needs to be higher than zero"));
 	CurrentHealth = FMath::Min(CurrentHealth + HealingAmount, MaxHealth);
+	PushHealthToHUD();
 }
 
 #pragma endregion
@@ -459,6 +583,7 @@ void AMurphysLawCharacter::Relive()
 {
 	Dead = false;
 	CurrentHealth = MaxHealth;
+	PushHealthToHUD();
 	Inventory->Reinitialize();
 	EquipFirstWeapon();
 
@@ -466,7 +591,7 @@ void AMurphysLawCharacter::Relive()
 	SetActorEnableCollision(true);
 }
 
-// Executed when the Dead variable is replicated
+// Executed when the Dead variable is changed by the vitals
 void AMurphysLawCharacter::OnRep_Dead()
 {
 	// When the character is revived by the server, we reinitialize his inventory
@@ -497,6 +622,8 @@ void AMurphysLawCharacter::EquipFirstWeapon()
 			Inventory->GetFullMeshWeapon(i)->SetActorHiddenInGame(false);
 		}
 	}
+
+	PushWeaponToHUD();
 }
 
 // Reports if the character is dead 
@@ -563,6 +690,10 @@ void AMurphysLawCharacter::ComputeBulletCollisions()
 
 	bool AtLeastOneHit = false;
 
+	// The server only hears the shots of the bots and of the listen server's player, clients report theirs when they hit
+	if (Role == ROLE_Authority)
+		NotifyGunshot();
+
 	// Trace lines to detect pawn
 	for (int32 i = 0; i < GetEquippedWeapon()->GetNumberOfEmittedFragments(); ++i)
 	{
@@ -624,6 +755,7 @@ float AMurphysLawCharacter::GetDeliveredDamage(const FHitResult& CollisionResult
 bool AMurphysLawCharacter::Server_TransferDamage_Validate(class AActor * DamagedActor, const float DamageAmount, struct FDamageEvent const & DamageEvent, class AController * EventInstigator, class AActor * DamageCauser) { return true; }
 void AMurphysLawCharacter::Server_TransferDamage_Implementation(class AActor * DamagedActor, const float DamageAmount, struct FDamageEvent const & DamageEvent, class AController * EventInstigator, class AActor * DamageCauser)
 {
+	NotifyGunshot();
 	DamagedActor->TakeDamage(DamageAmount, DamageEvent, EventInstigator, DamageCauser);
 }
 
@@ -640,6 +772,14 @@ float AMurphysLawCharacter::TakeDamage(float DamageAmount, struct FDamageEvent c
 			// If the player actually took damage
 			if (ActualDamage > 0.f)
 			{
+				// The shooter and its target stay relevant to each other for a while
+				MurphysLawRelevancyGrid* RelevancyGrid = MurphysLawRelevancyGrid::Get(GetWorld());
+				if (RelevancyGrid != nullptr && EventInstigator != nullptr)
+				{
+					RelevancyGrid->NotifyShotAt(GetController(), EventInstigator->GetPawn(), GetWorld()->GetTimeSeconds());
+					RelevancyGrid->NotifyShotAt(EventInstigator, this, GetWorld()->GetTimeSeconds());
+				}
+
 				// If the character has a HUD, we show the damages on it
 				auto MyController = Cast<AMurphysLawPlayerController>(GetController());
 				if (MyController != nullptr)
@@ -688,6 +828,7 @@ void AMurphysLawCharacter::OnReceiveAnyDamage(float Damage, const UDamageType* D
 	}
 
 	CurrentHealth = FMath::Max(CurrentHealth - Damage, 0.f);
+	PushHealthToHUD();
 
 	if (CurrentHealth <= 0.f)
 	{
@@ -696,6 +837,14 @@ void AMurphysLawCharacter::OnReceiveAnyDamage(float Damage, const UDamageType* D
 	}
 }
 
+// Makes the character relevant to the connections within hearing distance of the gunshot
+void AMurphysLawCharacter::NotifyGunshot()
+{
+	MurphysLawRelevancyGrid* RelevancyGrid = MurphysLawRelevancyGrid::Get(GetWorld());
+	if (RelevancyGrid != nullptr)
+		RelevancyGrid->NotifyNoise(this, GetActorLocation(), GetWorld()->GetTimeSeconds());
+}
+
 bool AMurphysLawCharacter::Server_TakeDamage_Validate(float DamageAmount, struct FDamageEvent const & DamageEvent, class AController * EventInstigator, AActor * DamageCauser) { return true; }
 void AMurphysLawCharacter::Server_TakeDamage_Implementation(float DamageAmount, struct FDamageEvent const & DamageEvent, class AController * EventInstigator, AActor * DamageCauser)
 {
@@ -838,9 +987,10 @@ void AMurphysLawCharacter::EquipWeapon(int32 Index)
 	GetEquippedWeapon()->IsReloading = false;
 
 	// Plays a sound when switching weapon if available
-	if (SwitchingWeaponSound != nullptr)
+	USoundBase* SwitchSound = SwitchingWeaponSound.Get();
+	if (SwitchSound != nullptr)
 	{
-		UGameplayStatics::PlaySoundAtLocation(this, SwitchingWeaponSound, GetActorLocation());
+		UGameplayStatics::PlaySoundAtLocation(this, SwitchSound, GetActorLocation());
 	}
 
 	// If the server modifies the value of the property, it is sent to the clients automatically
@@ -856,7 +1006,7 @@ void AMurphysLawCharacter::EquipWeapon(int32 Index)
 }
 
 // Replicates the current weapon index
-bool AMurphysLawCharacter::Server_ChangeCurrentWeapon_Validate(int32 Index) { return true; }
+bool AMurphysLawCharacter::Server_ChangeCurrentWeapon_Validate(int32 Index) { return Index >= 0 && Index < FMurphysLawCharacterVitals::NO_WEAPON_SLOT; }
 void AMurphysLawCharacter::Server_ChangeCurrentWeapon_Implementation(int32 Index)
 {
 	int32 OldIndex = CurrentWeaponIndex;
@@ -864,7 +1014,7 @@ void AMurphysLawCharacter::Server_ChangeCurrentWeapon_Implementation(int32 Index
 	OnRep_CurrentWeaponIndex(OldIndex);
 }
 
-// Executed when CurrentWeaponIndex is replicated
+// Executed when CurrentWeaponIndex is changed by the vitals
 void AMurphysLawCharacter::OnRep_CurrentWeaponIndex(int32 OldIndex)
 {
 	auto OldWeapon = Inventory->GetWeapon(OldIndex);
@@ -878,6 +1028,8 @@ void AMurphysLawCharacter::OnRep_CurrentWeaponIndex(int32 OldIndex)
 	// And show the new ones
 	if (HasWeaponEquipped()) GetEquippedWeapon()->SetActorHiddenInGame(false);
 	if (NewFullMeshWeapon != nullptr) NewFullMeshWeapon->SetActorHiddenInGame(false);
+
+	PushWeaponToHUD();
 }
 
 void AMurphysLawCharacter::ToggleCrouch()
@@ -968,11 +1120,23 @@ void AMurphysLawCharacter::Jump()
 	Super::Jump();
 
 	UpdateStaminaLevel(-JumpStaminaDecayAmount);
+
+	// The server never runs Jump for a remote player, it is told to drain the stamina too
+	if (Role < ROLE_Authority && IsLocallyControlled())
+	{
+		Server_ConsumeJumpStamina();
+	}
 }
 
 // Changes the IsRunning state
 void AMurphysLawCharacter::SetIsRunning(bool NewValue)
 {
+	// The server drains the stamina too, so it has to know when the owner starts or stops running
+	if (IsRunning != NewValue && Role < ROLE_Authority && IsLocallyControlled())
+	{
+		Server_SetIsRunning(NewValue);
+	}
+
 	IsRunning = NewValue;
 
 	// If the character starts running, we change its speed
@@ -987,6 +1151,76 @@ void AMurphysLawCharacter::SetIsRunning(bool NewValue)
 	}
 }
 
+// Lets the server know that the character runs, so both sides drain the same stamina
+bool AMurphysLawCharacter::Server_SetIsRunning_Validate(bool NewValue) { return true; }
+void AMurphysLawCharacter::Server_SetIsRunning_Implementation(bool NewValue)
+{
+	SetIsRunning(NewValue);
+}
+
+// Lets the server know that the character jumped, so both sides drain the same stamina
+bool AMurphysLawCharacter::Server_ConsumeJumpStamina_Validate() { return true; }
+void AMurphysLawCharacter::Server_ConsumeJumpStamina_Implementation()
+{
+	UpdateStaminaLevel(-JumpStaminaDecayAmount);
+}
+
+// Packs the current state of the character in the replicated vitals
+void AMurphysLawCharacter::UpdateReplicatedVitals()
+{
+	FMurphysLawCharacterVitals Vitals;
+	Vitals.Dead = Dead;
+	if (CurrentWeaponIndex >= 0 && CurrentWeaponIndex < FMurphysLawCharacterVitals::NO_WEAPON_SLOT)
+		Vitals.WeaponSlot = CurrentWeaponIndex;
+
+	// The other clients only render the character, they don't need its levels
+	PublicVitals = Vitals;
+
+	Vitals.HasDetails = true;
+	Vitals.Health = FMurphysLawCharacterVitals::Quantize(CurrentHealth, MaxHealth);
+	Vitals.Stamina = FMurphysLawCharacterVitals::Quantize(CurrentStamina, MaxStamina);
+	OwnerVitals = Vitals;
+}
+
+// Applies the vitals received from the server
+void AMurphysLawCharacter::ApplyVitals(const FMurphysLawCharacterVitals& Vitals)
+{
+	// Reviving reequips the first weapon, so it is applied before the weapon slot
+	if (Dead != (Vitals.Dead != 0))
+	{
+		Dead = Vitals.Dead != 0;
+		OnRep_Dead();
+	}
+
+	const int32 NewWeaponIndex = Vitals.WeaponSlot == FMurphysLawCharacterVitals::NO_WEAPON_SLOT ? NO_WEAPON_VALUE : Vitals.WeaponSlot;
+	if (NewWeaponIndex != CurrentWeaponIndex)
+	{
+		const int32 OldIndex = CurrentWeaponIndex;
+		CurrentWeaponIndex = NewWeaponIndex;
+		OnRep_CurrentWeaponIndex(OldIndex);
+	}
+
+	if (Vitals.HasDetails)
+	{
+		CurrentHealth = FMurphysLawCharacterVitals::Dequantize(Vitals.Health, MaxHealth);
+		PushHealthToHUD();
+
+		// The owner predicts its own stamina, it is only corrected when it drifts too much
+		const float ServerStamina = FMurphysLawCharacterVitals::Dequantize(Vitals.Stamina, MaxStamina);
+		if (FMath::Abs(ServerStamina - CurrentStamina) > STAMINA_CORRECTION_TOLERANCE)
+		{
+			CurrentStamina = ServerStamina;
+			PushStaminaToHUD();
+		}
+	}
+}
+
+// Executed when the vitals of the owner are replicated
+void AMurphysLawCharacter::OnRep_OwnerVitals() { ApplyVitals(OwnerVitals); }
+
+// Executed when the vitals of the other clients are replicated
+void AMurphysLawCharacter::OnRep_PublicVitals() { ApplyVitals(PublicVitals); }
+
 // Reports the current stamina level
 float AMurphysLawCharacter::GetCurrentStaminaLevel() const { return CurrentStamina; }
 
@@ -1001,6 +1235,53 @@ void AMurphysLawCharacter::UpdateStaminaLevel(float StaminaChange)
 
 	// Make sure the value stays between 0 and its maximum value
 	CurrentStamina = UKismetMathLibrary::FClamp(GetCurrentStaminaLevel(), 0.f, GetMaxStaminaLevel());
+	PushStaminaToHUD();
+}
+
+// Called by a weapon of the inventory when its ammo changes
+void AMurphysLawCharacter::OnWeaponAmmoChanged(const AMurphysLawBaseWeapon* Weapon)
+{
+	if (Weapon != nullptr && Weapon == GetEquippedWeapon())
+		PushWeaponToHUD();
+}
+
+// Reports the HUD of the player controlling the character, null for bots and remote players
+UMurphysLawHUDWidget* AMurphysLawCharacter::GetHUD() const
+{
+	AMurphysLawPlayerController* PlayerController = Cast<AMurphysLawPlayerController>(GetController());
+	return PlayerController != nullptr && PlayerController->IsLocalController() ? PlayerController->GetHUDInstance() : nullptr;
+}
+
+// Pushes the health level to the HUD
+void AMurphysLawCharacter::PushHealthToHUD() const
+{
+	if (UMurphysLawHUDWidget* HUD = GetHUD())
+		HUD->SetHealth(CurrentHealth, MaxHealth);
+}
+
+// Pushes the stamina level to the HUD
+void AMurphysLawCharacter::PushStaminaToHUD() const
+{
+	if (UMurphysLawHUDWidget* HUD = GetHUD())
+		HUD->SetStamina(CurrentStamina, MaxStamina);
+}
+
+// Pushes the equipped weapon and its ammo to the HUD
+void AMurphysLawCharacter::PushWeaponToHUD() const
+{
+	UMurphysLawHUDWidget* HUD = GetHUD();
+	if (HUD == nullptr) return;
+
+	if (HasWeaponEquipped())
+	{
+		HUD->SetWeaponName(GetEquippedWeapon()->GetWeaponName());
+		HUD->SetAmmo(GetEquippedWeapon()->GetNumberOfAmmoLeftInMagazine(), GetEquippedWeapon()->GetNumberOfAmmoLeftInInventory());
+	}
+	else
+	{
+		HUD->SetWeaponName(TEXT("-- No Name --"));
+		HUD->SetAmmo(0, 0);
+	}
 }
 
 // Determines if an actor is an hittable actor
@@ -1,14 +1,67 @@
 // Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
 #pragma once
 #include "GameFramework/Character.h"
+#include "GenericTeamAgentInterface.h"
 #include "../Interface/MurphysLawIObjectCollector.h"
 #include <MurphysLaw/Settings/Teams/MurphysLawTeamColor.h>
 #include "MurphysLawCharacter.generated.h"
 
 class UInputComponent;
 
+/**
+ * What the clients need to know about the health, stamina and weapon of a character,
+ * packed in a few bytes with a custom NetSerialize.
+ * Health and stamina are quantized on a byte and only serialized when HasDetails is set.
+ */
+USTRUCT()
+struct FMurphysLawCharacterVitals
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** Weapon slot used when the character has no weapon in hand */
+	static const uint8 NO_WEAPON_SLOT = 3;
+
+	/** Health level, 255 being the maximum health of the character */
+	uint8 Health;
+
+	/** Stamina level, 255 being the maximum stamina of the character */
+	uint8 Stamina;
+
+	/** Indicates if the character is dead */
+	uint8 Dead : 1;
+
+	/** Index of the weapon in hand or NO_WEAPON_SLOT */
+	uint8 WeaponSlot : 2;
+
+	/** Indicates if the health and stamina levels are serialized */
+	uint8 HasDetails : 1;
+
+	FMurphysLawCharacterVitals();
+
+	/** Writes or reads the packed vitals */
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FMurphysLawCharacterVitals& Other) const;
+
+	/** Converts a level between zero and its maximum to a byte */
+	static uint8 Quantize(float Value, float MaxValue);
+
+	/** Converts a byte back to a level between zero and its maximum */
+	static float Dequantize(uint8 Value, float MaxValue);
+};
+
+template<>
+struct TStructOpsTypeTraits<FMurphysLawCharacterVitals> : public TStructOpsTypeTraitsBase
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
+
 UCLASS(config=Game)
-class AMurphysLawCharacter : public ACharacter, public IMurphysLawIObjectCollector
+class AMurphysLawCharacter : public ACharacter, public IMurphysLawIObjectCollector, public IGenericTeamAgentInterface
 {
 	GENERATED_BODY()
 
@@ -37,14 +90,10 @@ class AMurphysLawCharacter : public ACharacter, public IMurphysLawIObjectCollect
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
 	class UCameraComponent* FirstPersonCameraComponent;
 
-	/** Scene Component */
+	/** Scene Component, where the name of the character is drawn by the nameplate overlay */
 	UPROPERTY(VisibleDefaultsOnly, Category = "Scene")
 	class USceneComponent* SceneComponent;
 
-	/** Character's name */
-	UPROPERTY(VisibleDefaultsOnly, Category = "Name")
-	class UWidgetComponent* CharacterNameplate;
-
 	bool IsCharacterAiming = false;
 	bool InAir = false;
 	float HighestZ;
@@ -70,12 +119,27 @@ public:
 	/** Defines a world-space point where an ai should look */
 	class AActor* GetFocalPoint() const;
 
+	/** Reports the team of the player controlling the character, so the bots only perceive their enemies */
+	FGenericTeamId GetGenericTeamId() const override;
+
+	/** Registers the character again with the sight of the bots, which keeps the team a target had when registered */
+	void UpdatePerceptionTeam();
+
 	/** Called when the character is possessed by a new controller */
 	void PossessedBy(AController* NewController) override;
 
+	/** Called when the character is no longer possessed by its controller */
+	void UnPossessed() override;
+
+	/** Executed on the clients when the player state of the character is replicated */
+	void OnRep_PlayerState() override;
+
 	/** Indicates to the server what properties of the object to replicate on the clients */
 	void GetLifetimeReplicatedProps(TArray<FLifetimeProperty> &OutLifetimeProps) const override;
 
+	/** Uses the relevancy grid of the server to decide if the character is sent to a connection */
+	bool IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation) const override;
+
 	// Provide a color for the meshes of the character
 	void SetMeshTeamColorTint(const MurphysLawTeamColor& TeamColor);
 
@@ -137,8 +201,8 @@ public:
 	/** Returns FirstPersonCameraComponent subobject **/
 	FORCEINLINE class UCameraComponent* GetFirstPersonCameraComponent() const { return FirstPersonCameraComponent; }
 
-	/** Returns  subobject **/
-	FORCEINLINE class UWidgetComponent* GetCharacterNameplate() const { return CharacterNameplate; }
+	/** Reports where the name of the character is drawn */
+	FVector GetNameplateLocation() const;
 
 	/** Called from TeleportTo() when teleport succeeds */
 	void TeleportSucceeded(bool bIsATest) override;
@@ -181,11 +245,11 @@ protected:
 
 private:
 	/** The current health level of the character */
-	UPROPERTY(Replicated, VisibleAnywhere, Category = "Health")
+	UPROPERTY(VisibleAnywhere, Category = "Health")
 	float CurrentHealth;
 
 	/** Bool that shows if the player is dead or alive */
-	UPROPERTY(Replicated, ReplicatedUsing = OnRep_Dead, VisibleAnywhere, Category = "Life")
+	UPROPERTY(VisibleAnywhere, Category = "Life")
 	bool Dead;
 
 #pragma endregion
@@ -277,13 +341,16 @@ public:
 	/** Function to update the character's stamina */
 	void UpdateStaminaLevel(float StaminaChange);
 
+	/** Called by a weapon of the inventory when its ammo changes */
+	void OnWeaponAmmoChanged(const class AMurphysLawBaseWeapon* Weapon);
+
 protected: 
 	/** Gets the player state casted to MurphysLawPlayerState */
 	class AMurphysLawPlayerState* GetPlayerState() const;
 
-	/** The sound that will be played when switching weapon */
+	/** The sound that will be played when switching weapon, loaded when the character begins to play */
 	UPROPERTY(EditDefaultsOnly, Category = "Weapon")
-	class USoundBase* SwitchingWeaponSound;
+	TAssetPtr<class USoundBase> SwitchingWeaponSound;
 
 	void EquipFirstWeapon();
 
@@ -293,9 +360,19 @@ protected:
 
 private:
 	/** The index of the weapon in the inventory that the character is holding */
-	UPROPERTY(Replicated, ReplicatedUsing = OnRep_CurrentWeaponIndex)
 	int32 CurrentWeaponIndex;
 
+	/** Stamina difference tolerated before the owner adopts the stamina of the server */
+	static const float STAMINA_CORRECTION_TOLERANCE;
+
+	/** Vitals sent to the owner, with the health and stamina levels */
+	UPROPERTY(ReplicatedUsing = OnRep_OwnerVitals)
+	FMurphysLawCharacterVitals OwnerVitals;
+
+	/** Vitals sent to the other clients, only what they render */
+	UPROPERTY(ReplicatedUsing = OnRep_PublicVitals)
+	FMurphysLawCharacterVitals PublicVitals;
+
 	/** Keeps the running state of the character */
 	bool IsRunning;
 
@@ -340,15 +417,53 @@ private:
 	/** Changes the IsRunning state */
 	void SetIsRunning(bool NewValue);
 
-	/** Executed when CurrentWeaponIndex is replicated */
-	UFUNCTION()
+	/** Lets the server know that the character runs, so both sides drain the same stamina */
+	UFUNCTION(Server, Reliable, WithValidation)
+	void Server_SetIsRunning(bool NewValue);
+
+	/** Lets the server know that the character jumped, so both sides drain the same stamina */
+	UFUNCTION(Server, Reliable, WithValidation)
+	void Server_ConsumeJumpStamina();
+
+	/** Executed when CurrentWeaponIndex is changed by the vitals */
 	void OnRep_CurrentWeaponIndex(int32 OldIndex);
 
-	/** Executed when the Dead variable is replicated */
-	UFUNCTION()
+	/** Executed when the Dead variable is changed by the vitals */
 	void OnRep_Dead();
 
+	/** Packs the current state of the character in the replicated vitals */
+	void UpdateReplicatedVitals();
+
+	/** Applies the vitals received from the server */
+	void ApplyVitals(const FMurphysLawCharacterVitals& Vitals);
+
+	/** Executed when the vitals of the owner are replicated */
+	UFUNCTION()
+	void OnRep_OwnerVitals();
+
+	/** Executed when the vitals of the other clients are replicated */
+	UFUNCTION()
+	void OnRep_PublicVitals();
+
 	/** Determines if an actor is an hittable actor */
 	static bool IsHittableActor(AActor* OtherActor);
+
+	/** Makes the character relevant to the connections within hearing distance of the gunshot */
+	void NotifyGunshot();
+
+	/** Reports the HUD of the player controlling the character, null for bots and remote players */
+	class UMurphysLawHUDWidget* GetHUD() const;
+
+	/** Pushes the health level to the HUD */
+	void PushHealthToHUD() const;
+
+	/** Pushes the stamina level to the HUD */
+	void PushStaminaToHUD() const;
+
+	/** Pushes the equipped weapon and its ammo to the HUD */
+	void PushWeaponToHUD() const;
+
+	/** Lets the nameplate overlays know that the teammates have to be recomputed */
+	void NotifyTeamAffiliationChanged() const;
 };
 
@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MurphysLaw.h"
+#include "MurphysLawDamageOverTime.h"
+#include "MurphysLawDamageZone.h"
+#include "../Network/MurphysLawGameMode.h"
+
+DECLARE_CYCLE_STAT(TEXT("Damage over time"), STAT_ML_DamageOverTime, STATGROUP_MurphysLaw);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Damage zones active"), STAT_ML_DamageZonesActive, STATGROUP_MurphysLaw);
+
+// Starts damaging the occupants of the zone, one interval from now
+void MurphysLawDamageOverTime::Activate(AMurphysLawDamageZone* Zone, float Time)
+{
+	if (ActiveZones.ContainsByPredicate([Zone](const ActiveZone& Other) { return Other.Zone == Zone; })) return;
+
+	ActiveZone& NewZone = ActiveZones[ActiveZones.AddDefaulted()];
+	NewZone.Zone = Zone;
+	NewZone.NextDamageTime = Time + Zone->GetDamageTickInterval();
+	SET_DWORD_STAT(STAT_ML_DamageZonesActive, ActiveZones.Num());
+}
+
+// Stops damaging the occupants of the zone
+void MurphysLawDamageOverTime::Deactivate(AMurphysLawDamageZone* Zone)
+{
+	ActiveZones.RemoveAllSwap([Zone](const ActiveZone& Other) { return Other.Zone == Zone; });
+	SET_DWORD_STAT(STAT_ML_DamageZonesActive, ActiveZones.Num());
+}
+
+// Damages the occupants of the due zones
+void MurphysLawDamageOverTime::Tick(UWorld* World)
+{
+	if (ActiveZones.Num() == 0) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_ML_DamageOverTime);
+
+	const float Time = World->GetTimeSeconds();
+
+	// Killing an occupant can make its zone empty, so the zones are collected before being damaged
+	TArray<AMurphysLawDamageZone*, TInlineAllocator<16> > DueZones;
+	for (ActiveZone& Active : ActiveZones)
+	{
+		AMurphysLawDamageZone* Zone = Active.Zone.Get();
+		if (Zone == nullptr || Time < Active.NextDamageTime) continue;
+
+		Active.NextDamageTime = Time + Zone->GetDamageTickInterval();
+		DueZones.Add(Zone);
+	}
+
+	for (AMurphysLawDamageZone* Zone : DueZones)
+		Zone->DamageOccupants();
+
+	ActiveZones.RemoveAllSwap([](const ActiveZone& Other) { return !Other.Zone.IsValid(); });
+}
+
+// Reports the processor of the game mode, null on clients
+MurphysLawDamageOverTime* MurphysLawDamageOverTime::Get(const UWorld* World)
+{
+	AMurphysLawGameMode* GameMode = World != nullptr ? Cast<AMurphysLawGameMode>(World->GetAuthGameMode()) : nullptr;
+	return GameMode != nullptr ? &GameMode->GetDamageOverTime() : nullptr;
+}
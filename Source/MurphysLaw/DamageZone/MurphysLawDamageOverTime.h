@@ -0,0 +1,35 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+/**
+ * Server side processor applying the damage of all the occupied damage zones in one pass per frame.
+ *
+ * A zone is only known to the processor while something stands in it, so the zones nobody
+ * is standing in cost nothing. Each active zone damages its occupants at its own interval.
+ */
+class MURPHYSLAW_API MurphysLawDamageOverTime
+{
+	/** A damage zone with occupants */
+	struct ActiveZone
+	{
+		TWeakObjectPtr<class AMurphysLawDamageZone> Zone;
+		float NextDamageTime;
+	};
+
+	/** The zones with occupants */
+	TArray<ActiveZone> ActiveZones;
+
+public:
+	/** Starts damaging the occupants of the zone, one interval from now */
+	void Activate(class AMurphysLawDamageZone* Zone, float Time);
+
+	/** Stops damaging the occupants of the zone */
+	void Deactivate(class AMurphysLawDamageZone* Zone);
+
+	/** Damages the occupants of the due zones */
+	void Tick(UWorld* World);
+
+	/** Reports the processor of the game mode, null on clients */
+	static MurphysLawDamageOverTime* Get(const UWorld* World);
+};
@@ -3,6 +3,7 @@
 #include "MurphysLaw.h"
 #include "../Character/MurphysLawCharacter.h"
 #include "MurphysLawDamageZone.h"
+#include "MurphysLawDamageOverTime.h"
 
 
 // Sets default values
@@ -21,10 +22,17 @@ void AMurphysLawDamageZone::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// Activate collision checking
+	// Only the server follows who stands in the zone
 	if (Role == ROLE_Authority)
 	{
-		GetWorldTimerManager().SetTimer(CollisionCheckHandle, this, &AMurphysLawDamageZone::DamagePlayers, DamageTickInterval, true);
+		SphereContact->OnComponentBeginOverlap.AddDynamic(this, &AMurphysLawDamageZone::OnBeginOverlap);
+		SphereContact->OnComponentEndOverlap.AddDynamic(this, &AMurphysLawDamageZone::OnEndOverlap);
+
+		// The actors already in the zone when it is spawned
+		TArray<AActor*> OverlappingActors;
+		SphereContact->GetOverlappingActors(OverlappingActors);
+		for (AActor* OtherActor : OverlappingActors)
+			AddOccupant(OtherActor);
 	}
 }
 
@@ -33,21 +41,64 @@ void AMurphysLawDamageZone::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
-	//Clear the TimerHandle_DealDamage
-	GetWorldTimerManager().ClearTimer(CollisionCheckHandle);
+	// Remove event handlers
+	SphereContact->OnComponentBeginOverlap.RemoveDynamic(this, &AMurphysLawDamageZone::OnBeginOverlap);
+	SphereContact->OnComponentEndOverlap.RemoveDynamic(this, &AMurphysLawDamageZone::OnEndOverlap);
+
+	Occupants.Reset();
+	MurphysLawDamageOverTime* DamageOverTime = MurphysLawDamageOverTime::Get(GetWorld());
+	if (DamageOverTime != nullptr) DamageOverTime->Deactivate(this);
 }
 
-void AMurphysLawDamageZone::DamagePlayers()
+// Damages the actors standing in the zone, called by the damage over time processor
+void AMurphysLawDamageZone::DamageOccupants()
 {
-	TArray<AActor*> OverlappingActors;
-	SphereContact->GetOverlappingActors(OverlappingActors);
+	// The occupants can leave the zone when they take damage, a copy is damaged
+	const TArray<TWeakObjectPtr<AActor>, TInlineAllocator<8> > Victims(Occupants);
 
 	FHitResult HitResult;
-	for(int32 i = 0; i < OverlappingActors.Num(); ++i)
+	FPointDamageEvent CollisionDamageEvent(Damage, HitResult, FVector::ZeroVector, UDamageType::StaticClass());
+	for (const TWeakObjectPtr<AActor>& Victim : Victims)
 	{
-		AActor* OtherActor = OverlappingActors[i];
-		FVector HurtDirection = OtherActor->GetActorLocation() - GetActorLocation();
-		FPointDamageEvent CollisionDamageEvent(Damage, HitResult, HurtDirection, UDamageType::StaticClass());
+		AActor* OtherActor = Victim.Get();
+		if (OtherActor == nullptr) continue;
+
+		CollisionDamageEvent.ShotDirection = OtherActor->GetActorLocation() - GetActorLocation();
 		OtherActor->TakeDamage(Damage, CollisionDamageEvent, nullptr, this);
 	}
 }
+
+// Reports the number of seconds between two damages
+float AMurphysLawDamageZone::GetDamageTickInterval() const { return DamageTickInterval; }
+
+// Event handler when an actor enters the zone
+void AMurphysLawDamageZone::OnBeginOverlap(AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	if (OtherActor != nullptr && OtherActor != this) AddOccupant(OtherActor);
+}
+
+// Event handler when an actor leaves the zone
+void AMurphysLawDamageZone::OnEndOverlap(AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	// Another component of the actor can still be in the zone
+	if (OtherActor == nullptr || SphereContact->IsOverlappingActor(OtherActor)) return;
+
+	Occupants.RemoveSwap(OtherActor);
+	Occupants.RemoveAllSwap([](const TWeakObjectPtr<AActor>& Occupant) { return !Occupant.IsValid(); });
+
+	// Nobody to damage anymore, the zone costs nothing until someone comes in
+	MurphysLawDamageOverTime* DamageOverTime = MurphysLawDamageOverTime::Get(GetWorld());
+	if (Occupants.Num() == 0 && DamageOverTime != nullptr) DamageOverTime->Deactivate(this);
+}
+
+// Adds an actor standing in the zone if it can be damaged and moved, the zone becomes active with its first occupant
+void AMurphysLawDamageZone::AddOccupant(AActor* Occupant)
+{
+	// The static floor and props overlap the zone too, they would keep it active forever.
+	// The characters and the barrels, which explode from the damage, are kept.
+	if (!Occupant->bCanBeDamaged || !Occupant->IsRootComponentMovable() || Occupants.Contains(Occupant)) return;
+	Occupants.Add(Occupant);
+
+	MurphysLawDamageOverTime* DamageOverTime = MurphysLawDamageOverTime::Get(GetWorld());
+	if (Occupants.Num() == 1 && DamageOverTime != nullptr) DamageOverTime->Activate(this, GetWorld()->GetTimeSeconds());
+}
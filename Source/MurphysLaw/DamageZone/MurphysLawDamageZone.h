@@ -22,7 +22,8 @@ class MURPHYSLAW_API AMurphysLawDamageZone : public AActor
 	UPROPERTY(VisibleDefaultsOnly, Category = "DamageZone")
 	class USphereComponent* SphereContact;
 
-	FTimerHandle CollisionCheckHandle;
+	/** The damageable actors standing in the zone, kept from the overlap events */
+	TArray<TWeakObjectPtr<AActor> > Occupants;
 
 public:	
 	// Sets default values for this actor's properties
@@ -33,7 +34,22 @@ public:
 
 	// Called when game ends
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
-	
+
+	/** Damages the actors standing in the zone, called by the damage over time processor */
+	void DamageOccupants();
+
+	/** Reports the number of seconds between two damages */
+	float GetDamageTickInterval() const;
+
 private:
-	void DamagePlayers();
+	/** Event handler when an actor enters the zone */
+	UFUNCTION()
+	void OnBeginOverlap(class AActor* OtherActor, class UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+	/** Event handler when an actor leaves the zone */
+	UFUNCTION()
+	void OnEndOverlap(class AActor* OtherActor, class UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+
+	/** Adds an actor standing in the zone if it can be damaged and moved, the zone becomes active with its first occupant */
+	void AddOccupant(AActor* Occupant);
 };
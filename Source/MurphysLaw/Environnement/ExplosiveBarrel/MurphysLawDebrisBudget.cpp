@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MurphysLaw.h"
+#include "MurphysLawDebrisBudget.h"
+#include "MurphysLawExplosiveBarrel.h"
+#include "../../Network/MurphysLawGameState.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Debris live barrels"), STAT_ML_DebrisLiveBarrels, STATGROUP_MurphysLaw);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Debris settled early"), STAT_ML_DebrisSettledEarly, STATGROUP_MurphysLaw);
+
+static TAutoConsoleVariable<int32> CVarDebrisMaxLive(
+	TEXT("MurphysLaw.Debris.MaxLive"),
+	4,
+	TEXT("Maximum number of exploded barrels whose chunks are simulated at the same time.\n")
+	TEXT("The oldest are replaced by their static debris first."));
+
+// Makes room for the chunks of a barrel that was just fractured
+void MurphysLawDebrisBudget::Add(AMurphysLawExplosiveBarrel* Barrel)
+{
+	LiveBarrels.RemoveAll([](const TWeakObjectPtr<AMurphysLawExplosiveBarrel>& Other) { return !Other.IsValid(); });
+
+	const int32 MaxLive = FMath::Max(CVarDebrisMaxLive.GetValueOnGameThread(), 1);
+	while (LiveBarrels.Num() >= MaxLive)
+	{
+		// The oldest chunks have had the most time to come to rest
+		INC_DWORD_STAT(STAT_ML_DebrisSettledEarly);
+		AMurphysLawExplosiveBarrel* Oldest = LiveBarrels[0].Get();
+		LiveBarrels.RemoveAt(0);
+		Oldest->SettleDebris();
+	}
+
+	LiveBarrels.Add(Barrel);
+	SET_DWORD_STAT(STAT_ML_DebrisLiveBarrels, LiveBarrels.Num());
+}
+
+// Forgets a barrel whose chunks have been replaced by its debris
+void MurphysLawDebrisBudget::Remove(AMurphysLawExplosiveBarrel* Barrel)
+{
+	LiveBarrels.Remove(Barrel);
+	SET_DWORD_STAT(STAT_ML_DebrisLiveBarrels, LiveBarrels.Num());
+}
+
+// Reports the budget of the game state, null until the game state exists
+MurphysLawDebrisBudget* MurphysLawDebrisBudget::Get(const UWorld* World)
+{
+	AMurphysLawGameState* GameState = World != nullptr ? World->GetGameState<AMurphysLawGameState>() : nullptr;
+	return GameState != nullptr ? &GameState->GetDebrisBudget() : nullptr;
+}
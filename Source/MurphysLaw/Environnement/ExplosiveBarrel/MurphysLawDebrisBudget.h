@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+/**
+ * Limits the number of exploded barrels whose chunks are simulated at the same time, on the clients.
+ *
+ * Each exploded barrel settles on its own after a few seconds and is replaced by a static debris mesh.
+ * When too many barrels are simulating at once, the oldest are settled first to make room.
+ * The limit is set with MurphysLaw.Debris.MaxLive.
+ */
+class MURPHYSLAW_API MurphysLawDebrisBudget
+{
+	/** The barrels whose chunks are simulated, the oldest first */
+	TArray<TWeakObjectPtr<class AMurphysLawExplosiveBarrel> > LiveBarrels;
+
+public:
+	/** Makes room for the chunks of a barrel that was just fractured */
+	void Add(class AMurphysLawExplosiveBarrel* Barrel);
+
+	/** Forgets a barrel whose chunks have been replaced by its debris */
+	void Remove(class AMurphysLawExplosiveBarrel* Barrel);
+
+	/** Reports the budget of the game state, null until the game state exists */
+	static MurphysLawDebrisBudget* Get(const UWorld* World);
+};
@@ -0,0 +1,101 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MurphysLaw.h"
+#include "MurphysLawExplosionQueue.h"
+#include "../../Network/MurphysLawGameMode.h"
+
+DECLARE_CYCLE_STAT(TEXT("Explosions"), STAT_ML_Explosions, STATGROUP_MurphysLaw);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Explosions resolved"), STAT_ML_ExplosionsResolved, STATGROUP_MurphysLaw);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Explosion visibility traces"), STAT_ML_ExplosionTraces, STATGROUP_MurphysLaw);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Explosions pending"), STAT_ML_ExplosionsPending, STATGROUP_MurphysLaw);
+
+const float MurphysLawExplosionQueue::CHAIN_REACTION_DELAY(0.1f);
+const int32 MurphysLawExplosionQueue::MAX_EXPLOSIONS_PER_FRAME(2);
+
+// Resolves the explosion after the delay
+void MurphysLawExplosionQueue::Enqueue(const Explosion& NewExplosion, float Delay, float Time)
+{
+	PendingExplosion& NewPending = Pending[Pending.AddDefaulted()];
+	NewPending.Data = NewExplosion;
+	NewPending.ResolveTime = Time + Delay;
+
+	Pending.StableSort([](const PendingExplosion& A, const PendingExplosion& B) { return A.ResolveTime < B.ResolveTime; });
+	SET_DWORD_STAT(STAT_ML_ExplosionsPending, Pending.Num());
+}
+
+// Resolves the due explosions, up to the maximum of a frame
+void MurphysLawExplosionQueue::Tick(UWorld* World)
+{
+	if (Pending.Num() == 0) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_ML_Explosions);
+
+	const float Time = World->GetTimeSeconds();
+
+	// The explosions caused while resolving are added to the queue, so the due ones are taken out first
+	TArray<Explosion, TInlineAllocator<4> > Due;
+	while (Pending.Num() > 0 && Due.Num() < MAX_EXPLOSIONS_PER_FRAME && Pending[0].ResolveTime <= Time)
+	{
+		Due.Add(Pending[0].Data);
+		Pending.RemoveAt(0, 1, false);
+	}
+
+	for (const Explosion& Resolved : Due)
+		Resolve(World, Resolved);
+
+	SET_DWORD_STAT(STAT_ML_ExplosionsPending, Pending.Num());
+}
+
+// Reports the queue of the game mode, null on clients
+MurphysLawExplosionQueue* MurphysLawExplosionQueue::Get(const UWorld* World)
+{
+	AMurphysLawGameMode* GameMode = World != nullptr ? Cast<AMurphysLawGameMode>(World->GetAuthGameMode()) : nullptr;
+	return GameMode != nullptr ? &GameMode->GetExplosionQueue() : nullptr;
+}
+
+// Damages the actors in the radius of the explosion that it can see
+void MurphysLawExplosionQueue::Resolve(UWorld* World, const Explosion& Resolved)
+{
+	INC_DWORD_STAT(STAT_ML_ExplosionsResolved);
+
+	static const FName ExplosionOverlapName(TEXT("ExplosionOverlap"));
+	static const FName ExplosionTraceName(TEXT("ExplosionTrace"));
+
+	AActor* Causer = Resolved.Causer.Get();
+
+	// Same query as the radial damage of the engine
+	FCollisionQueryParams OverlapParams(ExplosionOverlapName, false, Causer);
+	TArray<FOverlapResult> Overlaps;
+	World->OverlapMultiByObjectType(Overlaps, Resolved.Origin, FQuat::Identity, FCollisionObjectQueryParams(FCollisionObjectQueryParams::InitType::AllDynamicObjects), FCollisionShape::MakeSphere(Resolved.OuterRadius), OverlapParams);
+
+	for (const FOverlapResult& Overlap : Overlaps)
+	{
+		AActor* Victim = Overlap.GetActor();
+		UPrimitiveComponent* Component = Overlap.Component.Get();
+		if (Victim == nullptr || Component == nullptr || !Victim->bCanBeDamaged) continue;
+
+		FHitResult Hit(Victim, Component, Component->Bounds.Origin, (Component->Bounds.Origin - Resolved.Origin).GetSafeNormal());
+		HitsPerActor.FindOrAdd(Victim).Add(Hit);
+	}
+
+	FCollisionQueryParams TraceParams(ExplosionTraceName, true, Causer);
+	FRadialDamageEvent DamageEvent;
+	DamageEvent.DamageTypeClass = UDamageType::StaticClass();
+	DamageEvent.Origin = Resolved.Origin;
+	DamageEvent.Params = FRadialDamageParams(Resolved.BaseDamage, Resolved.MinimumDamage, Resolved.InnerRadius, Resolved.OuterRadius, Resolved.DamageFalloff);
+
+	for (auto& Pair : HitsPerActor)
+	{
+		// One trace for the actor, shared by all its components in the radius
+		INC_DWORD_STAT(STAT_ML_ExplosionTraces);
+		FHitResult Blocker;
+		const bool IsBlocked = World->LineTraceSingleByChannel(Blocker, Resolved.Origin, Pair.Key->GetActorLocation(), ECC_Visibility, TraceParams)
+			&& Blocker.GetActor() != Pair.Key;
+		if (IsBlocked) continue;
+
+		DamageEvent.ComponentHits = Pair.Value;
+		Pair.Key->TakeDamage(Resolved.BaseDamage, DamageEvent, Resolved.Instigator.Get(), Causer);
+	}
+
+	HitsPerActor.Reset();
+}
@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+/**
+ * Server side queue resolving the radial damage of the explosions over the next frames.
+ *
+ * Each explosion runs a single overlap and a single visibility trace per damaged actor,
+ * whatever the number of its components in the radius. An explosion caused by another one
+ * is delayed a little, so a cluster of barrels goes off as a chain over several frames instead
+ * of recursively in the same frame, and at most a few explosions are resolved per frame.
+ */
+class MURPHYSLAW_API MurphysLawExplosionQueue
+{
+public:
+	/** Number of seconds between an explosion and the explosions it causes */
+	static const float CHAIN_REACTION_DELAY;
+
+	/** The radial damage of an explosion */
+	struct Explosion
+	{
+		FVector Origin;
+		float BaseDamage;
+		float MinimumDamage;
+		float InnerRadius;
+		float OuterRadius;
+		float DamageFalloff;
+		TWeakObjectPtr<AActor> Causer;
+		TWeakObjectPtr<AController> Instigator;
+	};
+
+private:
+	/** Maximum number of explosions resolved in a frame, the others wait for the next frames */
+	static const int32 MAX_EXPLOSIONS_PER_FRAME;
+
+	/** An explosion waiting to be resolved */
+	struct PendingExplosion
+	{
+		Explosion Data;
+		float ResolveTime;
+	};
+
+	/** The explosions waiting to be resolved, by resolve time */
+	TArray<PendingExplosion> Pending;
+
+	/** The components in the radius of the explosion being resolved, grouped by actor, emptied after each explosion */
+	TMap<AActor*, TArray<FHitResult> > HitsPerActor;
+
+public:
+	/** Resolves the explosion after the delay */
+	void Enqueue(const Explosion& NewExplosion, float Delay, float Time);
+
+	/** Resolves the due explosions, up to the maximum of a frame */
+	void Tick(UWorld* World);
+
+	/** Reports the queue of the game mode, null on clients */
+	static MurphysLawExplosionQueue* Get(const UWorld* World);
+
+private:
+	/** Damages the actors in the radius of the explosion that it can see */
+	void Resolve(UWorld* World, const Explosion& Resolved);
+};
@@ -2,9 +2,12 @@
 
 #include "MurphysLaw.h"
 #include "MurphysLawExplosiveBarrel.h"
+#include "MurphysLawExplosionQueue.h"
+#include "MurphysLawDebrisBudget.h"
 
 #include "UnrealNetwork.h"
 
+const float AMurphysLawExplosiveBarrel::DEBRIS_COLLISION_HEIGHT_RATIO(0.25f);
 
 AMurphysLawExplosiveBarrel::AMurphysLawExplosiveBarrel()
 {
@@ -14,6 +17,9 @@ AMurphysLawExplosiveBarrel::AMurphysLawExplosiveBarrel()
 	// Enable network replication
 	bReplicates = true;
 
+	// Barrels are placed in the level and only wake up when damaged
+	NetDormancy = DORM_Initial;
+
 	// Health properties
 	MaxHealth = 10.f;	
 
@@ -24,10 +30,23 @@ AMurphysLawExplosiveBarrel::AMurphysLawExplosiveBarrel()
 	ExplosionDoFullDamage = true;
 	ExplosionDamage = 200.f;
 	ExplosionMinimalDamage = 10.f;
+	DebrisSettleTime = 5.f;
 
 	// Create the destructible component
 	DestructibleObject = CreateDefaultSubobject<UDestructibleComponent>(TEXT("DestructibleComponent"));
 	DestructibleObject->AttachTo(RootComponent);
+
+	// Create the debris shown once the chunks have settled, it only blocks like the barrel did once visible
+	DebrisObject = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("DebrisComponent"));
+	DebrisObject->AttachTo(DestructibleObject);
+	DebrisObject->SetHiddenInGame(true);
+	DebrisObject->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	// Create the collision standing for the chunks on a dedicated server, sized from the barrel when it explodes
+	DebrisCollision = CreateDefaultSubobject<UBoxComponent>(TEXT("DebrisCollisionComponent"));
+	DebrisCollision->AttachTo(DestructibleObject);
+	DebrisCollision->SetCollisionProfileName(UCollisionProfile::BlockAllDynamic_ProfileName);
+	DebrisCollision->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 }
 
 void AMurphysLawExplosiveBarrel::BeginPlay() 
@@ -38,6 +57,56 @@ void AMurphysLawExplosiveBarrel::BeginPlay()
 	if(DestructibleObject->GetDestructibleMesh() == nullptr) ShowWarning("ExplosiveBarrel - No destructible mesh assigned");
 }
 
+// Called when the barrel is removed from the game
+void AMurphysLawExplosiveBarrel::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	GetWorldTimerManager().ClearTimer(TimerHandle_SettleDebris);
+
+	MurphysLawDebrisBudget* DebrisBudget = MurphysLawDebrisBudget::Get(GetWorld());
+	if (DebrisBudget != nullptr) DebrisBudget->Remove(this);
+}
+
+// Replaces the simulated chunks by the static debris, or puts them to sleep on a client when there is no debris
+void AMurphysLawExplosiveBarrel::SettleDebris()
+{
+	GetWorldTimerManager().ClearTimer(TimerHandle_SettleDebris);
+
+	MurphysLawDebrisBudget* DebrisBudget = MurphysLawDebrisBudget::Get(GetWorld());
+	if (DebrisBudget != nullptr) DebrisBudget->Remove(this);
+
+	if (DestructibleObject == nullptr || DestructibleObject->IsPendingKill()) return;
+
+	const bool HasDebrisMesh = DebrisObject->StaticMesh != nullptr;
+
+	// Without debris, removing the chunks would leave nothing visible where the barrel was, they stay but stop simulating
+	if (!HasDebrisMesh && GetNetMode() != NM_DedicatedServer)
+	{
+		DestructibleObject->PutAllRigidBodiesToSleep();
+		return;
+	}
+
+	// Nothing is seen on a dedicated server, a low box blocks where the chunks lie on the clients
+	UPrimitiveComponent* Debris = DebrisObject;
+	if (!HasDebrisMesh)
+	{
+		const FBoxSphereBounds& Bounds = DestructibleObject->Bounds;
+		const float HalfHeight = Bounds.BoxExtent.Z * DEBRIS_COLLISION_HEIGHT_RATIO;
+		DebrisCollision->SetBoxExtent(FVector(Bounds.BoxExtent.X, Bounds.BoxExtent.Y, HalfHeight));
+		DebrisCollision->SetWorldLocation(Bounds.Origin - FVector(0.f, 0.f, Bounds.BoxExtent.Z - HalfHeight));
+		Debris = DebrisCollision;
+	}
+
+	// Removes the barrel from the physics scene, the debris stays where the barrel was
+	Debris->DetachFromParent(true);
+	SetRootComponent(Debris);
+	DestructibleObject->DestroyComponent();
+
+	if (HasDebrisMesh) DebrisObject->SetHiddenInGame(false);
+	Debris->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+}
+
 // Defines replicated members
 void AMurphysLawExplosiveBarrel::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
@@ -78,8 +147,20 @@ void AMurphysLawExplosiveBarrel::Server_TakeDamage_Implementation(float DamageAm
 bool AMurphysLawExplosiveBarrel::Multicast_Explode_Validate() { return true; }
 void AMurphysLawExplosiveBarrel::Multicast_Explode_Implementation()
 {
+	// Nobody sees the chunks of a dedicated server, the barrel is replaced right away by something that blocks like them
+	if (GetNetMode() == NM_DedicatedServer)
+	{
+		SettleDebris();
+		return;
+	}
+
 	// Destroy the destructable only !!!
 	DestructibleObject->ApplyRadiusDamage(MAX_FLT, GetActorLocation(), ExplosionOutterRadius, ExplosionImpulseStrength, ExplosionDoFullDamage);
+
+	// The oldest chunks are replaced by their debris when too many are simulated
+	MurphysLawDebrisBudget* DebrisBudget = MurphysLawDebrisBudget::Get(GetWorld());
+	if (DebrisBudget != nullptr) DebrisBudget->Add(this);
+	GetWorldTimerManager().SetTimer(TimerHandle_SettleDebris, this, &AMurphysLawExplosiveBarrel::SettleDebris, DebrisSettleTime, false);
 }
 
 // Server-side notification that damages were received
@@ -88,6 +169,8 @@ void AMurphysLawExplosiveBarrel::OnReceiveAnyDamage(float Damage, const UDamageT
 	// Check if not dead yet and that inflicted damage just killed it
 	if (CurrentHealth > 0)
 	{
+		// Send the new health (and the explosion) before going back to sleep
+		FlushNetDormancy();
 		CurrentHealth = FMath::Max(CurrentHealth - Damage, 0.f);
 
 		if (CurrentHealth == 0)
@@ -95,9 +178,28 @@ void AMurphysLawExplosiveBarrel::OnReceiveAnyDamage(float Damage, const UDamageT
 			// Destroy the barrel
 			Multicast_Explode();
 
-			// Deal damage over zone
-			TArray<AActor*> IgnoredActors;
-			UGameplayStatics::ApplyRadialDamageWithFalloff(this, ExplosionDamage, ExplosionMinimalDamage, GetActorLocation(), ExplosionInnerRadius, ExplosionOutterRadius, 10.f, UDamageType::StaticClass(), IgnoredActors, this, InstigatedBy);
+			// Deal damage over zone, in a later frame when the barrel was blown up by another one
+			MurphysLawExplosionQueue* ExplosionQueue = MurphysLawExplosionQueue::Get(GetWorld());
+			if (ExplosionQueue != nullptr)
+			{
+				MurphysLawExplosionQueue::Explosion Explosion;
+				Explosion.Origin = GetActorLocation();
+				Explosion.BaseDamage = ExplosionDamage;
+				Explosion.MinimumDamage = ExplosionMinimalDamage;
+				Explosion.InnerRadius = ExplosionInnerRadius;
+				Explosion.OuterRadius = ExplosionOutterRadius;
+				Explosion.DamageFalloff = 10.f;
+				Explosion.Causer = this;
+				Explosion.Instigator = InstigatedBy;
+
+				const float Delay = Cast<AMurphysLawExplosiveBarrel>(DamageCauser) != nullptr ? MurphysLawExplosionQueue::CHAIN_REACTION_DELAY : 0.f;
+				ExplosionQueue->Enqueue(Explosion, Delay, GetWorld()->GetTimeSeconds());
+			}
+			else
+			{
+				TArray<AActor*> IgnoredActors;
+				UGameplayStatics::ApplyRadialDamageWithFalloff(this, ExplosionDamage, ExplosionMinimalDamage, GetActorLocation(), ExplosionInnerRadius, ExplosionOutterRadius, 10.f, UDamageType::StaticClass(), IgnoredActors, this, InstigatedBy);
+			}
 		}
 	}
 }
@@ -18,6 +18,24 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Destruction", meta = (AllowPrivateAccess = "true"))
 	class UDestructibleComponent* DestructibleObject;
 
+	/** The static mesh replacing the chunks once they have settled, hidden until then */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Destruction", meta = (AllowPrivateAccess = "true"))
+	class UStaticMeshComponent* DebrisObject;
+
+	/** Simple collision replacing the barrel on a dedicated server when no debris mesh is set */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Destruction", meta = (AllowPrivateAccess = "true"))
+	class UBoxComponent* DebrisCollision;
+
+	/** Part of the height of the barrel kept by the debris collision */
+	static const float DEBRIS_COLLISION_HEIGHT_RATIO;
+
+	/** Number of seconds the chunks are simulated before being replaced by the debris */
+	UPROPERTY(EditDefaultsOnly, Category = "Destruction")
+	float DebrisSettleTime;
+
+	/** Handle for the replacement of the chunks by the debris */
+	FTimerHandle TimerHandle_SettleDebris;
+
 	/** Represents if inflicted damage is the same for within explosion radius */
 	UPROPERTY(EditDefaultsOnly, Category = "Destruction")
 	bool ExplosionDoFullDamage;
@@ -66,6 +84,12 @@ public:
 	/** Called when the game starts or when spawned */
 	void BeginPlay() override;
 
+	/** Called when the barrel is removed from the game */
+	void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Replaces the simulated chunks by the static debris, or puts them to sleep on a client when there is no debris */
+	void SettleDebris();
+
 	/** Entry point for received damages */
 	float TakeDamage(float DamageAmount, const FDamageEvent & DamageEvent, AController* EventInstigator, AActor* DamageCauser) override;
 
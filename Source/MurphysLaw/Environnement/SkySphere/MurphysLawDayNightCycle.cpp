@@ -9,6 +9,9 @@
 #include "Engine/SkyLight.h"
 #include "UnrealNetwork.h"
 
+DECLARE_CYCLE_STAT(TEXT("Day night lighting update"), STAT_ML_DayNightLightingUpdate, STATGROUP_MurphysLaw);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Day night lighting updates"), STAT_ML_DayNightLightingUpdates, STATGROUP_MurphysLaw);
+
 // Constants
 const float AMurphysLawDayNightCycle::NB_SECONDS_IN_REAL_MINUTES(60.f);
 const float AMurphysLawDayNightCycle::NB_HOURS_IN_REAL_DAY(24.f);
@@ -26,14 +29,24 @@ AMurphysLawDayNightCycle::AMurphysLawDayNightCycle()
 	bCanBeDamaged = false;	// Disable collision and damage system
 	bBlockInput = true;		// Disable keyboard input
 	
-	/** Since the "client" cannot communicate to the server, the server will replicate the current in-game time.
-	However, since this is network intensive, the replication frequency will be very low */
+	/** Since the "client" cannot communicate to the server, the server will replicate when the cycle started.
+	It is only sent once to each client which then derives the in-game time from the time of the server, the actor sleeps afterward */
 	NetUpdateFrequency = MIN_flt; // Number of replication per seconds
+	NetDormancy = DORM_DormantAll;
 
 	// Defaults time properties
 	DayLengthInMinutes = 2.f;
 	InitialInGameHour = float(FMath::RandRange(0, 23));
 
+	// The sun moves a fraction of a degree per second, a few lighting updates per second are enough
+	LightingUpdateInterval = 0.25f;
+	MinSunAngleChange = 0.25f;
+	PrimaryActorTick.TickInterval = LightingUpdateInterval;
+
+	StartInGameHour = InitialInGameHour;
+	StartServerTime = 0.f;
+	AppliedSunAngle = -1.f;
+
 	// Actor references initialisation
 	SunLight = nullptr;
 	SkyDome = nullptr;
@@ -44,7 +57,8 @@ AMurphysLawDayNightCycle::AMurphysLawDayNightCycle()
 void AMurphysLawDayNightCycle::GetLifetimeReplicatedProps(TArray< FLifetimeProperty > & OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-	DOREPLIFETIME(AMurphysLawDayNightCycle, CurrentInGameHour);
+	DOREPLIFETIME(AMurphysLawDayNightCycle, StartInGameHour);
+	DOREPLIFETIME(AMurphysLawDayNightCycle, StartServerTime);
 }
 
 // Called when the game starts or when spawned
@@ -56,7 +70,13 @@ void AMurphysLawDayNightCycle::BeginPlay()
 	float OneInGameDayTimeInSeconds = DayLengthInMinutes * NB_SECONDS_IN_REAL_MINUTES;
 	InGameHourDuration = OneInGameDayTimeInSeconds / NB_HOURS_IN_REAL_DAY;
 
-	CurrentInGameHour = InitialInGameHour;
+	// The clients receive the start of the cycle of the server
+	if (Role == ROLE_Authority)
+	{
+		StartInGameHour = InitialInGameHour;
+		StartServerTime = GetWorld()->GetTimeSeconds();
+	}
+	UpdateInGameHour();
 
 	// Retreive scene reference
 	SkyLight = MurphysLawUtils::GetUniqueSceneReference<ASkyLight>(this);
@@ -67,6 +87,7 @@ void AMurphysLawDayNightCycle::BeginPlay()
 	if(SunLight != nullptr && SkyDome != nullptr && SkyLight != nullptr)
 	{
 		InitializeSceneReference();
+		SetActorTickInterval(LightingUpdateInterval);
 		SetActorTickEnabled(true);
 	}
 	else
@@ -82,18 +103,40 @@ void AMurphysLawDayNightCycle::InitializeSceneReference()
 	SunLight->SetMobility(EComponentMobility::Movable);
 }
 
-// Called every frame
+// Computes the virtual hour from the start of the cycle and the time of the server
+void AMurphysLawDayNightCycle::UpdateInGameHour()
+{
+	// Before the game state is replicated, the time of the client is the best guess
+	const AGameState* GameState = GetWorld()->GetGameState();
+	const float ServerTime = GameState != nullptr ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+
+	CurrentInGameHour = FMath::Fmod(StartInGameHour + FMath::Max(ServerTime - StartServerTime, 0.f) / InGameHourDuration, NB_HOURS_IN_REAL_DAY);
+}
+
+// Updates the lighting at the next tick
+void AMurphysLawDayNightCycle::OnRep_Start()
+{
+	AppliedSunAngle = -1.f;
+}
+
+// Called at LightingUpdateInterval
 void AMurphysLawDayNightCycle::Tick( float DeltaTime )
 {
 	Super::Tick( DeltaTime );
 
 	// Update position angle
-	CurrentInGameHour += (DeltaTime / InGameHourDuration);
-	if (CurrentInGameHour >= NB_HOURS_IN_REAL_DAY) CurrentInGameHour -= NB_HOURS_IN_REAL_DAY;
+	UpdateInGameHour();
 
 	SunAngle = (CurrentInGameHour * HOUR_TO_DEGREE_FACTOR) + SUN_DEGREE_OFFSET;
 	if(SunAngle >= 360.f) SunAngle -= 360.f;
 
+	// The lighting is only updated once the sun has visibly moved
+	if (AppliedSunAngle >= 0.f && FMath::Abs(FRotator::NormalizeAxis(SunAngle - AppliedSunAngle)) < MinSunAngleChange) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_ML_DayNightLightingUpdate);
+	INC_DWORD_STAT(STAT_ML_DayNightLightingUpdates);
+	AppliedSunAngle = SunAngle;
+
 	// Refresh sky's display
 	SunLight->SetActorRotation(FRotator(SunAngle, 0.f, 0.f));
 	SkyDome->UpdateSunOrientation();
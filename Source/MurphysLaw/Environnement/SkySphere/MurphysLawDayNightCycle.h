@@ -35,7 +35,7 @@ public:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 	
-	// Called every frame
+	// Called at LightingUpdateInterval
 	virtual void Tick( float DeltaSeconds ) override;
 
 protected:
@@ -47,6 +47,14 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "In Game time")
 	float InitialInGameHour;
 
+	/** Number of seconds between two updates of the lighting */
+	UPROPERTY(EditDefaultsOnly, Category = "In Game time")
+	float LightingUpdateInterval;
+
+	/** Number of degrees the sun has to move before the lighting is updated */
+	UPROPERTY(EditDefaultsOnly, Category = "In Game time")
+	float MinSunAngleChange;
+
 private:
 	/** A reference to the ambiant light */
 	class ASkyLight* SkyLight;
@@ -61,13 +69,31 @@ private:
 	UPROPERTY(VisibleAnywhere, Category = "In Game time")
 	float SunAngle;
 
-	/** The current virtual hour in the game */
-	UPROPERTY(VisibleAnywhere, Replicated, Category = "In Game time")
+	/** The current virtual hour in the game, derived from the start of the cycle */
+	UPROPERTY(VisibleAnywhere, Category = "In Game time")
 	float CurrentInGameHour;
 
+	/** The virtual hour when the cycle started, sent once to each client */
+	UPROPERTY(ReplicatedUsing = OnRep_Start)
+	float StartInGameHour;
+
+	/** The server time when the cycle started, sent once to each client */
+	UPROPERTY(ReplicatedUsing = OnRep_Start)
+	float StartServerTime;
+
+	/** The angle of the sun the lighting was last updated for, negative to force the next update */
+	float AppliedSunAngle;
+
 	/** The duration in seconds of a complete virtual day of 24 hours */
 	float InGameHourDuration;
 
 	/** Set scene parameters */
 	void InitializeSceneReference();
+
+	/** Computes the virtual hour from the start of the cycle and the time of the server */
+	void UpdateInGameHour();
+
+	/** Updates the lighting at the next tick */
+	UFUNCTION()
+	void OnRep_Start();
 };
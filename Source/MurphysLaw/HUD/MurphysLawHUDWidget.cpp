@@ -6,16 +6,57 @@
 #include "../Weapon/MurphysLawBaseWeapon.h"
 #include "../Network/MurphysLawPlayerController.h"
 #include "../Network/MurphysLawGameState.h"
+#include "../Network/MurphysLawPlayerState.h"
+#include "MurphysLawMinimapBounds.h"
 #include "Kismet/KismetMathLibrary.h"
 
 class AMurphysLawGameState;
 DEFINE_LOG_CATEGORY(ML_HUDWidget);
 
+DECLARE_CYCLE_STAT(TEXT("HUD view model update"), STAT_ML_HUDViewModelUpdate, STATGROUP_MurphysLaw);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HUD view model changes"), STAT_ML_HUDViewModelChanges, STATGROUP_MurphysLaw);
+DECLARE_CYCLE_STAT(TEXT("HUD messages and markers"), STAT_ML_HUDMessagesAndMarkers, STATGROUP_MurphysLaw);
+DECLARE_CYCLE_STAT(TEXT("HUD minimap layout"), STAT_ML_HUDMiniMapLayout, STATGROUP_MurphysLaw);
+
 UMurphysLawHUDWidget::UMurphysLawHUDWidget(const FObjectInitializer& ObjectInitializer)
 	: UUserWidget(ObjectInitializer)
 {
 	HitMarkerOpacity = 0.f;
 	DamageIndicatorOpacity = 0.f;
+	FirstOnScreenMessage = 0;
+	NumberOfOnScreenMessages = 0;
+	MiniMapBounds = nullptr;
+	MiniMapLayoutElapsed = 0.f;
+	MiniMapTeammatesVersion = INDEX_NONE;
+}
+
+// Lays out the baked minimap, expires the messages and fades the markers
+void UMurphysLawHUDWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+	Super::NativeTick(MyGeometry, InDeltaTime);
+
+	// The icons of the minimap don't need to move at the framerate
+	if (MiniMapBounds != nullptr)
+	{
+		MiniMapLayoutElapsed += InDeltaTime;
+		if (MiniMapLayoutElapsed >= MINIMAP_LAYOUT_INTERVAL)
+		{
+			MiniMapLayoutElapsed = FMath::Fmod(MiniMapLayoutElapsed, MINIMAP_LAYOUT_INTERVAL);
+			UpdateMiniMapLayout();
+		}
+	}
+
+	if (NumberOfOnScreenMessages == 0 && HitMarkerOpacity == 0.f && DamageIndicatorOpacity == 0.f) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_ML_HUDMessagesAndMarkers);
+
+	if (NumberOfOnScreenMessages > 0)
+		RemoveExpiredOnScreenMessages(GetWorld()->GetTimeSeconds());
+
+	// The markers keep fading at the same speed as when they were faded by steps
+	const float Steps = InDeltaTime / MARKERS_OPACITY_REDUCE_DELAY;
+	HitMarkerOpacity = FMath::Max(HitMarkerOpacity - HITMARKER_OPACITY_REDUCE_RATE * Steps, 0.f);
+	DamageIndicatorOpacity = FMath::Max(DamageIndicatorOpacity - DAMAGE_INDICATOR_OPACITY_REDUCE_RATE * Steps, 0.f);
 }
 
 // Sets the character who's information will be shown on the widget
@@ -29,8 +70,121 @@ void UMurphysLawHUDWidget::SetPlayerController(AMurphysLawPlayerController* Play
 
 	checkf(MyPlayerController != nullptr, TEXT("HUDWidget - MyPlayerController is null"));
 	checkf(MyCharacter != nullptr, TEXT("HUDWidget - MyCharacter is null"));
+
+	// Without baked texture, the blueprint keeps using the live scene capture
+	MiniMapBounds = AMurphysLawMinimapBounds::Find(GetWorld());
+	if (MiniMapBounds != nullptr)
+	{
+		MiniMapLayout.SetWorldBounds(MiniMapBounds->GetWorldCenter(), MiniMapBounds->GetWorldSize());
+		MiniMapTeammatesVersion = INDEX_NONE;
+		UpdateMiniMapLayout();
+	}
+
+	RefreshViewModel();
+}
+
+// Pulls every value of the view model, used when the HUD is created
+void UMurphysLawHUDWidget::RefreshViewModel()
+{
+	SetHealth(MyCharacter->GetCurrentHealthLevel(), MyCharacter->GetMaxHealthLevel());
+	SetStamina(MyCharacter->GetCurrentStaminaLevel(), MyCharacter->GetMaxStaminaLevel());
+
+	if (MyCharacter->HasWeaponEquipped())
+	{
+		SetWeaponName(MyCharacter->GetEquippedWeapon()->GetWeaponName());
+		SetAmmo(MyCharacter->GetEquippedWeapon()->GetNumberOfAmmoLeftInMagazine(), MyCharacter->GetEquippedWeapon()->GetNumberOfAmmoLeftInInventory());
+	}
+	else
+	{
+		SetWeaponName(TEXT("-- No Name --"));
+		SetAmmo(0, 0);
+	}
+
+	AMurphysLawGameState* GameState = Cast<AMurphysLawGameState>(GetWorld()->GetGameState());
+	if (GameState != nullptr)
+		SetMatchState(GameState->MurphysLawMatchState);
+}
+
+// Pushes the health level of the character
+void UMurphysLawHUDWidget::SetHealth(float CurrentHealth, float MaxHealth)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ML_HUDViewModelUpdate);
+
+	const float Percent = MaxHealth > 0.f ? CurrentHealth / MaxHealth : 0.f;
+	if (!HasPercentChanged(ViewModel.HealthPercent, Percent)) return;
+
+	ViewModel.HealthPercent = Percent;
+	NotifyViewModelChanged();
 }
 
+// Pushes the stamina level of the character
+void UMurphysLawHUDWidget::SetStamina(float CurrentStamina, float MaxStamina)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ML_HUDViewModelUpdate);
+
+	const float Percent = MaxStamina > 0.f ? CurrentStamina / MaxStamina : 0.f;
+	if (!HasPercentChanged(ViewModel.StaminaPercent, Percent)) return;
+
+	ViewModel.StaminaPercent = Percent;
+	NotifyViewModelChanged();
+}
+
+// Pushes the ammo of the equipped weapon
+void UMurphysLawHUDWidget::SetAmmo(int32 AmmoInMagazine, int32 AmmoInInventory)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ML_HUDViewModelUpdate);
+
+	if (AmmoInMagazine == ViewModel.AmmoInMagazine && AmmoInInventory == ViewModel.AmmoInInventory) return;
+
+	// The text is only formatted when the ammo changes
+	ViewModel.AmmoInMagazine = AmmoInMagazine;
+	ViewModel.AmmoInInventory = AmmoInInventory;
+	ViewModel.AmountOfAmmoText = FText::Format(FText::FromString("{0} | {1}"), FText::AsNumber(AmmoInMagazine), FText::AsNumber(AmmoInInventory));
+	NotifyViewModelChanged();
+}
+
+// Pushes the name of the equipped weapon
+void UMurphysLawHUDWidget::SetWeaponName(const FString& Name)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ML_HUDViewModelUpdate);
+
+	if (ViewModel.WeaponName.ToString() == Name) return;
+
+	ViewModel.WeaponName = FText::FromString(Name);
+	NotifyViewModelChanged();
+}
+
+// Pushes the state of the match
+void UMurphysLawHUDWidget::SetMatchState(MurphysLawMatchState State)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ML_HUDViewModelUpdate);
+
+	const ESlateVisibility GameTimerVisibility = State == MurphysLawMatchState::EPlaying ? ESlateVisibility::Visible : ESlateVisibility::Hidden;
+	const ESlateVisibility WarmUpTimerVisibility = State == MurphysLawMatchState::EWarmUp ? ESlateVisibility::Visible : ESlateVisibility::Hidden;
+	if (GameTimerVisibility == ViewModel.GameTimerVisibility && WarmUpTimerVisibility == ViewModel.WarmUpTimerVisibility) return;
+
+	ViewModel.GameTimerVisibility = GameTimerVisibility;
+	ViewModel.WarmUpTimerVisibility = WarmUpTimerVisibility;
+	NotifyViewModelChanged();
+}
+
+// Reports if a percentage changed enough to be shown, the full and empty bars are always reached exactly
+bool UMurphysLawHUDWidget::HasPercentChanged(float OldPercent, float NewPercent) const
+{
+	return NewPercent != OldPercent
+		&& (!FMath::IsNearlyEqual(NewPercent, OldPercent, PERCENT_TOLERANCE) || NewPercent == 0.f || NewPercent == 1.f);
+}
+
+// Lets the blueprint know that the view model changed
+void UMurphysLawHUDWidget::NotifyViewModelChanged()
+{
+	INC_DWORD_STAT(STAT_ML_HUDViewModelChanges);
+	OnViewModelChanged(ViewModel);
+}
+
+// Reports what the HUD shows
+const FMurphysLawHUDViewModel& UMurphysLawHUDWidget::GetViewModel() const { return ViewModel; }
+
 // Adjust the character's offset on the minimap
 FVector UMurphysLawHUDWidget::GetMiniMapActorLocation() const
 {
@@ -43,105 +197,168 @@ float UMurphysLawHUDWidget::GetMiniMapAngle() const
 	return MyCharacter->GetBearing() * -1.0f;
 }
 
-// Calculates the health percent of the character
-float UMurphysLawHUDWidget::GetHealthPercent() const
+// Reports if the minimap shows the baked texture of the level instead of the live scene capture
+bool UMurphysLawHUDWidget::IsMiniMapBaked() const { return MiniMapBounds != nullptr; }
+
+// Reports the baked texture of the level
+UTexture2D* UMurphysLawHUDWidget::GetMiniMapTexture() const
 {
-	return MyCharacter->GetCurrentHealthLevel() / MyCharacter->GetMaxHealthLevel();
+	return MiniMapBounds != nullptr ? MiniMapBounds->GetTexture() : nullptr;
 }
 
-// Formats the number of ammo of the character to be displayed
-FText UMurphysLawHUDWidget::GetAmountOfAmmoText() const
+// Reports the texture coordinates at the center of the minimap
+FVector2D UMurphysLawHUDWidget::GetMiniMapTextureCenter() const { return MiniMapLayout.GetTextureCenter(); }
+
+// Reports the part of the texture shown by the minimap, 1 for the whole texture
+float UMurphysLawHUDWidget::GetMiniMapTextureExtent() const { return MiniMapLayout.GetTextureExtent(); }
+
+// Reports the player and teammate icons of the baked minimap
+const TArray<FMurphysLawMinimapIcon>& UMurphysLawHUDWidget::GetMiniMapIcons() const { return MiniMapLayout.GetIcons(); }
+
+// Places the player and teammate icons on the baked minimap
+void UMurphysLawHUDWidget::UpdateMiniMapLayout()
 {
-	int32 AmountOfAmmoInWeapon = 0;
-	int32 AmountOfAmmoInInventory = 0;
+	if (MyCharacter == nullptr) return;
 
-	if (MyCharacter->HasWeaponEquipped())
+	SCOPE_CYCLE_COUNTER(STAT_ML_HUDMiniMapLayout);
+
+	AMurphysLawGameState* GameState = GetWorld()->GetGameState<AMurphysLawGameState>();
+	if (GameState != nullptr && MiniMapTeammatesVersion != GameState->GetTeamAffiliationVersion())
+		UpdateMiniMapTeammates(GameState->GetTeamAffiliationVersion());
+
+	MiniMapMarkers.Reset();
+	for (const TWeakObjectPtr<AMurphysLawCharacter>& Teammate : MiniMapTeammates)
 	{
-		AmountOfAmmoInWeapon = MyCharacter->GetEquippedWeapon()->GetNumberOfAmmoLeftInMagazine();
-		AmountOfAmmoInInventory = MyCharacter->GetEquippedWeapon()->GetNumberOfAmmoLeftInInventory();
+		if (!Teammate.IsValid() || Teammate->IsDead()) continue;
+
+		MurphysLawMinimapLayout::Marker& NewMarker = MiniMapMarkers[MiniMapMarkers.AddUninitialized()];
+		NewMarker.Location = Teammate->GetActorLocation();
+		NewMarker.Yaw = Teammate->GetActorRotation().Yaw;
 	}
 
-	return FText::Format(FText::FromString("{0} | {1}"), FText::AsNumber(AmountOfAmmoInWeapon), FText::AsNumber(AmountOfAmmoInInventory));
+	MurphysLawMinimapLayout::Marker LocalPlayer;
+	LocalPlayer.Location = MyCharacter->GetActorLocation();
+	LocalPlayer.Yaw = MyCharacter->GetBearing();
+
+	// The size and zoom can be changed by the blueprint
+	MiniMapLayout.SetMapSize(MapSize, MapZoom);
+	MiniMapLayout.Update(LocalPlayer, MiniMapMarkers);
+
+	OnMiniMapLayoutChanged();
+}
+
+// Recomputes the teammates shown on the baked minimap
+void UMurphysLawHUDWidget::UpdateMiniMapTeammates(int32 TeamAffiliationVersion)
+{
+	MiniMapTeammatesVersion = TeamAffiliationVersion;
+	MiniMapTeammates.Reset();
+
+	const AMurphysLawPlayerState* MyPlayerState = Cast<AMurphysLawPlayerState>(MyPlayerController->PlayerState);
+	if (MyPlayerState == nullptr || MyPlayerState->GetTeam() < 0) return;
+
+	for (TActorIterator<AMurphysLawCharacter> It(GetWorld()); It; ++It)
+	{
+		const AMurphysLawPlayerState* PlayerState = Cast<AMurphysLawPlayerState>(It->PlayerState);
+		if (*It == MyCharacter || PlayerState == nullptr || PlayerState == MyPlayerState) continue;
+
+		if (PlayerState->GetTeam() == MyPlayerState->GetTeam())
+			MiniMapTeammates.Add(*It);
+	}
+}
+
+// Calculates the health percent of the character
+float UMurphysLawHUDWidget::GetHealthPercent() const
+{
+	return ViewModel.HealthPercent;
+}
+
+// Formats the number of ammo of the character to be displayed
+FText UMurphysLawHUDWidget::GetAmountOfAmmoText() const
+{
+	return ViewModel.AmountOfAmmoText;
 }
 
 // Reports the Game Timer visibility
 ESlateVisibility UMurphysLawHUDWidget::GetGameTimerVisibility() const
 {
-	AMurphysLawGameState* GameState = Cast<AMurphysLawGameState>(GetWorld()->GetGameState());
-	return GameState != nullptr && GameState->MurphysLawMatchState == MurphysLawMatchState::EPlaying ? ESlateVisibility::Visible : ESlateVisibility::Hidden;
+	return ViewModel.GameTimerVisibility;
 }
 
 // Reports the Warm Up Timer visibility
 ESlateVisibility UMurphysLawHUDWidget::GetWarmUpTimerVisibility() const
 {
-	AMurphysLawGameState* GameState = Cast<AMurphysLawGameState>(GetWorld()->GetGameState());
-	return GameState != nullptr && GameState->MurphysLawMatchState == MurphysLawMatchState::EWarmUp ? ESlateVisibility::Visible : ESlateVisibility::Hidden;
+	return ViewModel.WarmUpTimerVisibility;
 }
 
 // Gets the OnScreenMessages string
 FText UMurphysLawHUDWidget::GetOnScreenMessages() const
 {
-	return FText::FromString(OnScreenMessages);
+	return OnScreenMessagesText;
 }
 
 // Adds a message to be shown on the screen
 void UMurphysLawHUDWidget::AddOnScreenMessage(FString InMessage)
 {
-	// Adds the message at the bottom of the stack
-	OnScreenMessages = OnScreenMessages.Append(InMessage + "\n");
+	// When the buffer is full, the oldest message makes room for the new one
+	if (NumberOfOnScreenMessages == MAX_ON_SCREEN_MESSAGES)
+	{
+		FirstOnScreenMessage = (FirstOnScreenMessage + 1) % MAX_ON_SCREEN_MESSAGES;
+		--NumberOfOnScreenMessages;
+	}
+
+	// Adds the message at the bottom of the stack, it is removed by NativeTick once expired
+	OnScreenMessage& Message = OnScreenMessages[(FirstOnScreenMessage + NumberOfOnScreenMessages) % MAX_ON_SCREEN_MESSAGES];
+	Message.Text = MoveTemp(InMessage);
+	Message.ExpiryTime = GetWorld()->GetTimeSeconds() + REMOVE_MESSAGE_DELAY;
+	++NumberOfOnScreenMessages;
 
-	// And starts a timer for the message to be removed
-	FTimerHandle TimerHandler;
-	GetWorld()->GetTimerManager().SetTimer(TimerHandler, this, &UMurphysLawHUDWidget::RemoveFirstOnScreenMessage, REMOVE_MESSAGE_DELAY);
+	UpdateOnScreenMessagesText();
 }
 
-// Removes the first message of the stack
-void UMurphysLawHUDWidget::RemoveFirstOnScreenMessage()
+// Removes the messages that have expired
+void UMurphysLawHUDWidget::RemoveExpiredOnScreenMessages(float Now)
 {
-	FString LeftPart, RightPart;
-
-	// Splits the string on the first occurence of a line break
-	if (OnScreenMessages.Split(TEXT("\n"), &LeftPart, &RightPart))
-	{		
-		// And stores the rest of the messages back in the OnScreenMessages
-		OnScreenMessages = RightPart;
+	// The messages expire in the order they were added
+	const int32 PreviousNumberOfMessages = NumberOfOnScreenMessages;
+	while (NumberOfOnScreenMessages > 0 && OnScreenMessages[FirstOnScreenMessage].ExpiryTime <= Now)
+	{
+		FirstOnScreenMessage = (FirstOnScreenMessage + 1) % MAX_ON_SCREEN_MESSAGES;
+		--NumberOfOnScreenMessages;
 	}
-	else
+
+	if (NumberOfOnScreenMessages != PreviousNumberOfMessages)
+		UpdateOnScreenMessagesText();
+}
+
+// Joins the messages of the ring buffer in OnScreenMessagesText
+void UMurphysLawHUDWidget::UpdateOnScreenMessagesText()
+{
+	FString Result;
+	for (int32 i = 0; i < NumberOfOnScreenMessages; ++i)
 	{
-		OnScreenMessages = TEXT("");
+		Result += OnScreenMessages[(FirstOnScreenMessage + i) % MAX_ON_SCREEN_MESSAGES].Text;
+		Result += TEXT("\n");
 	}
+
+	OnScreenMessagesText = FText::FromString(MoveTemp(Result));
 }
 
 // Calculates the stamina percentage of the character
 float UMurphysLawHUDWidget::GetStaminaPercent() const
 {
-	return MyCharacter->GetCurrentStaminaLevel() / MyCharacter->GetMaxStaminaLevel();
+	return ViewModel.StaminaPercent;
 }
 
 // Reports the equipped weapon name
 FText UMurphysLawHUDWidget::GetWeaponName() const
 {
-	FString Name = TEXT("-- No Name --");
-
-	if (MyCharacter->HasWeaponEquipped())
-	{
-		Name = MyCharacter->GetEquippedWeapon()->GetWeaponName();
-	}
-
-	return FText::FromString(Name);
+	return ViewModel.WeaponName;
 }
 
-// Changes HitMarker opacity to the max
+// Changes HitMarker opacity to the max, NativeTick fades it away
 void UMurphysLawHUDWidget::ShowHitMarker()
 {
-	bool MustStartTimer = HitMarkerOpacity == 0.f;	
 	HitMarkerOpacity = 1.f;
-
-	if (MustStartTimer)
-	{
-		FTimerHandle TimerHandle;
-		GetWorld()->GetTimerManager().SetTimer(TimerHandle, this, &UMurphysLawHUDWidget::LowerHitMarkerOpacity, MARKERS_OPACITY_REDUCE_DELAY);
-	}
 }
 
 // Reports the hitmarker color and opacity
@@ -150,29 +367,12 @@ FLinearColor UMurphysLawHUDWidget::GetHitMarkerColorAndOpacity() const
 	return FLinearColor(1.f, 1.f, 1.f, HitMarkerOpacity);
 }
 
-// Lowers the crosshair opacity
-void UMurphysLawHUDWidget::LowerHitMarkerOpacity()
-{
-	HitMarkerOpacity = UKismetMathLibrary::FMax(HitMarkerOpacity - HITMARKER_OPACITY_REDUCE_RATE, 0.f);
-	if (HitMarkerOpacity > 0.f)
-	{
-		FTimerHandle TimerHandle;
-		GetWorld()->GetTimerManager().SetTimer(TimerHandle, this, &UMurphysLawHUDWidget::LowerHitMarkerOpacity, MARKERS_OPACITY_REDUCE_DELAY);
-	}
-}
-
 // Implementable event in Blueprint that will change the orientation of the DamageIndicator
 void UMurphysLawHUDWidget::ShowDamage(float Angle)
 {
-	bool MustStartTimer = DamageIndicatorOpacity == 0.f;
+	// NativeTick fades it away
 	DamageIndicatorOpacity = 1.f;
 
-	if (MustStartTimer)
-	{
-		FTimerHandle TimerHandle;
-		GetWorld()->GetTimerManager().SetTimer(TimerHandle, this, &UMurphysLawHUDWidget::LowerDamageIndicatorOpacity, MARKERS_OPACITY_REDUCE_DELAY);
-	}
-
 	// Calls the blueprint event to actually change the rotation of the damage indicator
 	this->OnShowDamage(Angle);
 }
@@ -182,14 +382,3 @@ FLinearColor UMurphysLawHUDWidget::GetDamageIndicatorColorAndOpacity() const
 {
 	return FLinearColor(1.f, 0.f, 0.f, DamageIndicatorOpacity);
 }
-
-/** Lowers the DamageIndicator opacity */
-void UMurphysLawHUDWidget::LowerDamageIndicatorOpacity()
-{
-	DamageIndicatorOpacity = UKismetMathLibrary::FMax(DamageIndicatorOpacity - DAMAGE_INDICATOR_OPACITY_REDUCE_RATE, 0.f);
-	if (DamageIndicatorOpacity > 0.f)
-	{
-		FTimerHandle TimerHandle;
-		GetWorld()->GetTimerManager().SetTimer(TimerHandle, this, &UMurphysLawHUDWidget::LowerDamageIndicatorOpacity, MARKERS_OPACITY_REDUCE_DELAY);
-	}
-}
\ No newline at end of file
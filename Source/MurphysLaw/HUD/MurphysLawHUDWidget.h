@@ -3,10 +3,45 @@
 #pragma once
 
 #include "Blueprint/UserWidget.h"
+#include "MurphysLawMinimapLayout.h"
 #include "MurphysLawHUDWidget.generated.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(ML_HUDWidget, Log, All);
 
+enum class MurphysLawMatchState : uint8;
+
+/**
+ * Everything the HUD shows about the character and the match, pushed by the character,
+ * its weapons and the game state when it changes instead of being polled every frame.
+ */
+USTRUCT(BlueprintType)
+struct FMurphysLawHUDViewModel
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Health")
+	float HealthPercent = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Stamina")
+	float StaminaPercent = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon")
+	FText AmountOfAmmoText;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon")
+	FText WeaponName;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Timer")
+	ESlateVisibility GameTimerVisibility = ESlateVisibility::Hidden;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Timer")
+	ESlateVisibility WarmUpTimerVisibility = ESlateVisibility::Hidden;
+
+	/** The values the ammo text was formatted from */
+	int32 AmmoInMagazine = INDEX_NONE;
+	int32 AmmoInInventory = INDEX_NONE;
+};
+
 /**
  * 
  */
@@ -26,6 +61,26 @@ public:
 	UFUNCTION(BlueprintPure, Category = "MiniMap")
 	float GetMiniMapAngle() const;
 
+	/** Reports if the minimap shows the baked texture of the level instead of the live scene capture */
+	UFUNCTION(BlueprintPure, Category = "MiniMap")
+	bool IsMiniMapBaked() const;
+
+	/** Reports the baked texture of the level */
+	UFUNCTION(BlueprintPure, Category = "MiniMap")
+	class UTexture2D* GetMiniMapTexture() const;
+
+	/** Reports the texture coordinates at the center of the minimap */
+	UFUNCTION(BlueprintPure, Category = "MiniMap")
+	FVector2D GetMiniMapTextureCenter() const;
+
+	/** Reports the part of the texture shown by the minimap, 1 for the whole texture */
+	UFUNCTION(BlueprintPure, Category = "MiniMap")
+	float GetMiniMapTextureExtent() const;
+
+	/** Reports the player and teammate icons of the baked minimap */
+	UFUNCTION(BlueprintPure, Category = "MiniMap")
+	const TArray<FMurphysLawMinimapIcon>& GetMiniMapIcons() const;
+
 	/** Sets the character who's information will be shown on the widget */
 	void SetPlayerController(class AMurphysLawPlayerController* PlayerController);
 
@@ -54,6 +109,27 @@ public:
 	/** Changes DamageIndicator opacity to the max */
 	void ShowDamage(float Angle);
 
+	/** Lays out the baked minimap, expires the messages and fades the markers */
+	void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+
+	/** Pulls every value of the view model, used when the HUD is created */
+	void RefreshViewModel();
+
+	/** Pushes the health level of the character */
+	void SetHealth(float CurrentHealth, float MaxHealth);
+
+	/** Pushes the stamina level of the character */
+	void SetStamina(float CurrentStamina, float MaxStamina);
+
+	/** Pushes the ammo of the equipped weapon */
+	void SetAmmo(int32 AmmoInMagazine, int32 AmmoInInventory);
+
+	/** Pushes the name of the equipped weapon */
+	void SetWeaponName(const FString& Name);
+
+	/** Pushes the state of the match */
+	void SetMatchState(MurphysLawMatchState State);
+
 protected:
 	/** Keeps a reference to the character owning the HUD */
 	UPROPERTY(VisibleAnywhere)
@@ -91,19 +167,53 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, Category = "Damage")
 	void OnShowDamage(float Angle);
 
+	/** Reports what the HUD shows */
+	UFUNCTION(BlueprintPure, Category = "HUD")
+	const FMurphysLawHUDViewModel& GetViewModel() const;
+
+	/** Implementable event in Blueprint called once per change of the view model, so the widgets don't need bindings */
+	UFUNCTION(BlueprintImplementableEvent, Category = "HUD")
+	void OnViewModelChanged(const FMurphysLawHUDViewModel& NewViewModel);
+
+	/** Implementable event in Blueprint called each time the icons of the baked minimap are placed */
+	UFUNCTION(BlueprintImplementableEvent, Category = "MiniMap")
+	void OnMiniMapLayoutChanged();
+
 private:
 	/** The delay before an OnScreenMessage is removed */
 	const float REMOVE_MESSAGE_DELAY = 3.f;
 
-	/** The delay before the HitMarker opacity is lowered */
+	/** The maximum number of OnScreenMessages shown at once, the oldest one is replaced when full */
+	static const int32 MAX_ON_SCREEN_MESSAGES = 8;
+
+	/** The delay between two reductions of the markers opacity */
 	const float MARKERS_OPACITY_REDUCE_DELAY = 0.07f;
 
-	/** The rate at which the opacity of the HitMarker fades away */
+	/** The opacity of the HitMarker lost every MARKERS_OPACITY_REDUCE_DELAY */
 	const float HITMARKER_OPACITY_REDUCE_RATE = 0.125f;
 
-	/** The rate at which the opacity of the Damage Indication fades away */
+	/** The opacity of the Damage Indication lost every MARKERS_OPACITY_REDUCE_DELAY */
 	const float DAMAGE_INDICATOR_OPACITY_REDUCE_RATE = 0.075f;
 
+	/** A message shown on the screen until it expires */
+	struct OnScreenMessage
+	{
+		FString Text;
+		float ExpiryTime;
+	};
+
+	/** The smallest change of a percentage shown by the HUD */
+	const float PERCENT_TOLERANCE = 0.002f;
+
+	/** What the HUD shows */
+	FMurphysLawHUDViewModel ViewModel;
+
+	/** Lets the blueprint know that the view model changed */
+	void NotifyViewModelChanged();
+
+	/** Reports if a percentage changed enough to be shown */
+	bool HasPercentChanged(float OldPercent, float NewPercent) const;
+
 	/** Represents the HitMarker opacity */
 	float HitMarkerOpacity;
 
@@ -113,15 +223,49 @@ private:
 	/** Keeps the character instance from the PlayerController */
 	class AMurphysLawCharacter* MyCharacter;
 
-	/** Keeps all the OnScreen messages to be shown */
-	FString OnScreenMessages;
+	/** Ring buffer of the OnScreen messages to be shown, from the oldest to the newest */
+	OnScreenMessage OnScreenMessages[MAX_ON_SCREEN_MESSAGES];
+
+	/** Index of the oldest message in the ring buffer */
+	int32 FirstOnScreenMessage;
+
+	/** Number of messages in the ring buffer */
+	int32 NumberOfOnScreenMessages;
+
+	/** The messages joined together, rebuilt only when a message is added or removed */
+	FText OnScreenMessagesText;
+
+	/** The delay between two layouts of the baked minimap, 15 times per second */
+	const float MINIMAP_LAYOUT_INTERVAL = 1.f / 15.f;
+
+	/** The baked minimap of the level, null when the level uses the live scene capture */
+	UPROPERTY()
+	class AMurphysLawMinimapBounds* MiniMapBounds;
+
+	/** Places the icons on the baked minimap */
+	MurphysLawMinimapLayout MiniMapLayout;
+
+	/** Time since the last layout of the baked minimap */
+	float MiniMapLayoutElapsed;
+
+	/** The teammates shown on the baked minimap */
+	TArray<TWeakObjectPtr<class AMurphysLawCharacter> > MiniMapTeammates;
+
+	/** Version of the teams the teammates were computed from */
+	int32 MiniMapTeammatesVersion;
+
+	/** The teammates to place, kept from one layout to the other */
+	TArray<MurphysLawMinimapLayout::Marker> MiniMapMarkers;
+
+	/** Places the player and teammate icons on the baked minimap */
+	void UpdateMiniMapLayout();
 
-	/** Removes the first message of the stack */
-	void RemoveFirstOnScreenMessage();
+	/** Recomputes the teammates shown on the baked minimap */
+	void UpdateMiniMapTeammates(int32 TeamAffiliationVersion);
 
-	/** Lowers the HitMarker opacity */
-	void LowerHitMarkerOpacity();
+	/** Removes the messages that have expired */
+	void RemoveExpiredOnScreenMessages(float Now);
 
-	/** Lowers the DamageIndicator opacity */
-	void LowerDamageIndicatorOpacity();
+	/** Joins the messages of the ring buffer in OnScreenMessagesText */
+	void UpdateOnScreenMessagesText();
 };
@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MurphysLaw.h"
+#include "MurphysLawMinimapBounds.h"
+
+// Sets default values
+AMurphysLawMinimapBounds::AMurphysLawMinimapBounds()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	Texture = nullptr;
+	WorldSize = 20000.f;	// 200 meters
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+// Called when the game starts or when spawned
+void AMurphysLawMinimapBounds::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (Texture == nullptr)
+	{
+		ShowWarning("MurphysLawMinimapBounds - No texture assigned, the live minimap is kept");
+		return;
+	}
+
+	// The baked texture replaces the second render of the level
+	for (ASceneCapture2D* Capture : LiveCaptures)
+	{
+		if (Capture != nullptr)
+		{
+			Capture->GetCaptureComponent2D()->bCaptureEveryFrame = false;
+			Capture->GetCaptureComponent2D()->Deactivate();
+		}
+	}
+}
+
+// Reports the top-down texture of the level
+UTexture2D* AMurphysLawMinimapBounds::GetTexture() const { return Texture; }
+
+// Reports the center of the area covered by the texture
+FVector2D AMurphysLawMinimapBounds::GetWorldCenter() const { return FVector2D(GetActorLocation()); }
+
+// Reports the side of the area covered by the texture
+float AMurphysLawMinimapBounds::GetWorldSize() const { return WorldSize; }
+
+// Reports the bounds placed in the level, null if the level has no baked minimap
+AMurphysLawMinimapBounds* AMurphysLawMinimapBounds::Find(UWorld* World)
+{
+	for (TActorIterator<AMurphysLawMinimapBounds> It(World); It; ++It)
+	{
+		if (It->GetTexture() != nullptr) return *It;
+	}
+	return nullptr;
+}
@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "GameFramework/Actor.h"
+#include "MurphysLawMinimapBounds.generated.h"
+
+/**
+ * Placed once in a level to give the minimap a baked top-down texture of the level,
+ * centered on the actor and covering a square of WorldSize units.
+ * When present, the HUD lays out the minimap on the CPU instead of using a live scene capture.
+ */
+UCLASS()
+class MURPHYSLAW_API AMurphysLawMinimapBounds : public AActor
+{
+	GENERATED_BODY()
+
+	/** The top-down texture of the level, with the world X axis toward its top */
+	UPROPERTY(EditAnywhere, Category = "MiniMap")
+	class UTexture2D* Texture;
+
+	/** Side of the area covered by the texture, in world units */
+	UPROPERTY(EditAnywhere, Category = "MiniMap")
+	float WorldSize;
+
+	/** The scene captures used by the live minimap, stopped since the texture replaces them */
+	UPROPERTY(EditInstanceOnly, Category = "MiniMap")
+	TArray<class ASceneCapture2D*> LiveCaptures;
+
+public:
+	// Sets default values for this actor's properties
+	AMurphysLawMinimapBounds();
+
+	// Called when the game starts or when spawned
+	virtual void BeginPlay() override;
+
+	/** Reports the top-down texture of the level */
+	class UTexture2D* GetTexture() const;
+
+	/** Reports the center of the area covered by the texture */
+	FVector2D GetWorldCenter() const;
+
+	/** Reports the side of the area covered by the texture */
+	float GetWorldSize() const;
+
+	/** Reports the bounds placed in the level, null if the level has no baked minimap */
+	static AMurphysLawMinimapBounds* Find(UWorld* World);
+};
@@ -0,0 +1,73 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MurphysLaw.h"
+#include "MurphysLawMinimapLayout.h"
+
+const int32 MurphysLawMinimapLayout::EXPECTED_MAX_ICONS(16);
+
+MurphysLawMinimapLayout::MurphysLawMinimapLayout()
+	: WorldCenter(FVector2D::ZeroVector), WorldSize(1.f), MapSize(1.f), MapZoom(1.f), TextureCenter(0.5f, 0.5f)
+{
+	Icons.Reserve(EXPECTED_MAX_ICONS);
+}
+
+// Sets the area of the world covered by the texture
+void MurphysLawMinimapLayout::SetWorldBounds(const FVector2D& Center, float Size)
+{
+	WorldCenter = Center;
+	WorldSize = FMath::Max(Size, KINDA_SMALL_NUMBER);
+}
+
+// Sets the size of the minimap widget and the zoom applied to the texture
+void MurphysLawMinimapLayout::SetMapSize(float Size, float Zoom)
+{
+	MapSize = Size;
+	MapZoom = FMath::Max(Zoom, KINDA_SMALL_NUMBER);
+}
+
+// Converts a world location to texture coordinates, between 0 and 1 inside the covered area
+FVector2D MurphysLawMinimapLayout::WorldToTexture(const FVector& Location) const
+{
+	// The world Y axis goes to the right of the texture and the world X axis to its top
+	return FVector2D(
+		(Location.Y - WorldCenter.Y) / WorldSize + 0.5f,
+		0.5f - (Location.X - WorldCenter.X) / WorldSize);
+}
+
+// Places the local player at the center and the teammates around
+void MurphysLawMinimapLayout::Update(const Marker& LocalPlayer, const TArray<Marker>& Teammates)
+{
+	Icons.Reset();
+
+	TextureCenter = WorldToTexture(LocalPlayer.Location);
+
+	const FVector2D MapCenter(MapSize * 0.5f, MapSize * 0.5f);
+	const float TextureToMap = MapSize * MapZoom;
+	const float MaxRadiusSquared = FMath::Square(MapSize * 0.5f);
+
+	FMurphysLawMinimapIcon& PlayerIcon = Icons[Icons.AddDefaulted()];
+	PlayerIcon.Position = MapCenter;
+	PlayerIcon.Angle = LocalPlayer.Yaw;
+	PlayerIcon.IsLocalPlayer = true;
+
+	for (const Marker& Teammate : Teammates)
+	{
+		const FVector2D Offset = (WorldToTexture(Teammate.Location) - TextureCenter) * TextureToMap;
+
+		// Outside of the circle of the minimap
+		if (Offset.SizeSquared() > MaxRadiusSquared) continue;
+
+		FMurphysLawMinimapIcon& Icon = Icons[Icons.AddDefaulted()];
+		Icon.Position = MapCenter + Offset;
+		Icon.Angle = Teammate.Yaw;
+	}
+}
+
+// Reports the texture coordinates at the center of the minimap
+const FVector2D& MurphysLawMinimapLayout::GetTextureCenter() const { return TextureCenter; }
+
+// Reports the part of the texture shown by the minimap, 1 for the whole texture
+float MurphysLawMinimapLayout::GetTextureExtent() const { return 1.f / MapZoom; }
+
+// Reports the icons of the last layout
+const TArray<FMurphysLawMinimapIcon>& MurphysLawMinimapLayout::GetIcons() const { return Icons; }
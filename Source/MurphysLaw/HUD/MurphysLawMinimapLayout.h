@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "MurphysLawMinimapLayout.generated.h"
+
+/** An icon placed on the minimap */
+USTRUCT(BlueprintType)
+struct FMurphysLawMinimapIcon
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** Position of the icon, in the units of the minimap widget, from its top left corner */
+	UPROPERTY(BlueprintReadOnly, Category = "MiniMap")
+	FVector2D Position = FVector2D::ZeroVector;
+
+	/** Rotation of the icon, in degrees */
+	UPROPERTY(BlueprintReadOnly, Category = "MiniMap")
+	float Angle = 0.f;
+
+	/** Indicates if the icon is the local player, who is always at the center */
+	UPROPERTY(BlueprintReadOnly, Category = "MiniMap")
+	bool IsLocalPlayer = false;
+};
+
+/**
+ * Places the player and teammate icons on a minimap showing a baked top-down texture of the level.
+ *
+ * The texture is expected to be an orthographic capture looking down, with the world X axis
+ * toward the top of the texture, covering a square of WorldSize units centered on WorldCenter.
+ * The minimap is north-up and centered on the local player, only the teammates inside its circle are kept.
+ *
+ * Only math on vectors is done here, so the layout does not depend on a renderer.
+ */
+class MURPHYSLAW_API MurphysLawMinimapLayout
+{
+public:
+	/** A character to place on the minimap */
+	struct Marker
+	{
+		FVector Location;
+		float Yaw;
+	};
+
+private:
+	/** Number of icons reserved */
+	static const int32 EXPECTED_MAX_ICONS;
+
+	/** Center of the area covered by the texture, in world units */
+	FVector2D WorldCenter;
+
+	/** Side of the area covered by the texture, in world units */
+	float WorldSize;
+
+	/** Side of the minimap widget */
+	float MapSize;
+
+	/** Zoom applied to the texture, 1 shows the whole texture */
+	float MapZoom;
+
+	/** Texture coordinates at the center of the minimap */
+	FVector2D TextureCenter;
+
+	/** The icons of the last layout, the local player first */
+	TArray<FMurphysLawMinimapIcon> Icons;
+
+public:
+	MurphysLawMinimapLayout();
+
+	/** Sets the area of the world covered by the texture */
+	void SetWorldBounds(const FVector2D& Center, float Size);
+
+	/** Sets the size of the minimap widget and the zoom applied to the texture */
+	void SetMapSize(float Size, float Zoom);
+
+	/** Converts a world location to texture coordinates, between 0 and 1 inside the covered area */
+	FVector2D WorldToTexture(const FVector& Location) const;
+
+	/** Places the local player at the center and the teammates around */
+	void Update(const Marker& LocalPlayer, const TArray<Marker>& Teammates);
+
+	/** Reports the texture coordinates at the center of the minimap */
+	const FVector2D& GetTextureCenter() const;
+
+	/** Reports the part of the texture shown by the minimap, 1 for the whole texture */
+	float GetTextureExtent() const;
+
+	/** Reports the icons of the last layout */
+	const TArray<FMurphysLawMinimapIcon>& GetIcons() const;
+};
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MurphysLaw.h"
+#include "MurphysLawMinimapLayout.h"
+#include "AutomationTest.h"
+
+#if WITH_EDITOR
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMurphysLawMinimapLayoutTest, "MurphysLaw.HUD.MinimapLayout", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// Checks the texture coordinates, the culling of the teammates outside of the circle and their offsets
+bool FMurphysLawMinimapLayoutTest::RunTest(const FString& Parameters)
+{
+	MurphysLawMinimapLayout Layout;
+	Layout.SetWorldBounds(FVector2D::ZeroVector, 1000.f);
+	Layout.SetMapSize(200.f, 2.f);
+
+	// The world X axis goes to the top of the texture and the world Y axis to its right
+	TestTrue(TEXT("The center of the area is the center of the texture"), Layout.WorldToTexture(FVector::ZeroVector).Equals(FVector2D(0.5f, 0.5f)));
+	TestTrue(TEXT("Forward and right is the top right of the texture"), Layout.WorldToTexture(FVector(250.f, 250.f, 0.f)).Equals(FVector2D(0.75f, 0.25f)));
+	TestTrue(TEXT("The back left corner is the bottom left of the texture"), Layout.WorldToTexture(FVector(-500.f, -500.f, 0.f)).Equals(FVector2D(0.f, 1.f)));
+	TestTrue(TEXT("The height is ignored"), Layout.WorldToTexture(FVector(0.f, 0.f, 800.f)).Equals(FVector2D(0.5f, 0.5f)));
+	TestEqual(TEXT("The zoom shows a part of the texture"), Layout.GetTextureExtent(), 0.5f);
+
+	// The map is 200 units wide and zoomed twice, a texture unit is 400 map units and the circle has a radius of 100
+	MurphysLawMinimapLayout::Marker LocalPlayer = { FVector(0.f, 0.f, 0.f), 90.f };
+	TArray<MurphysLawMinimapLayout::Marker> Teammates;
+	Teammates.Add({ FVector(100.f, 0.f, 0.f), 45.f });
+	Teammates.Add({ FVector(0.f, -200.f, 0.f), 0.f });
+	Teammates.Add({ FVector(0.f, 300.f, 0.f), 0.f });
+	Teammates.Add({ FVector(200.f, 200.f, 0.f), 0.f });
+	Layout.Update(LocalPlayer, Teammates);
+
+	const TArray<FMurphysLawMinimapIcon>& Icons = Layout.GetIcons();
+	TestEqual(TEXT("The teammates outside of the circle are dropped"), Icons.Num(), 3);
+	if (Icons.Num() != 3) return false;
+
+	TestTrue(TEXT("The local player comes first"), Icons[0].IsLocalPlayer);
+	TestTrue(TEXT("The local player is at the center"), Icons[0].Position.Equals(FVector2D(100.f, 100.f)));
+	TestEqual(TEXT("The local player keeps its yaw"), Icons[0].Angle, 90.f);
+
+	TestFalse(TEXT("A teammate is not the local player"), Icons[1].IsLocalPlayer);
+	TestTrue(TEXT("A teammate in front is above the center"), Icons[1].Position.Equals(FVector2D(100.f, 60.f)));
+	TestEqual(TEXT("A teammate keeps its yaw"), Icons[1].Angle, 45.f);
+	TestTrue(TEXT("A teammate on the left is left of the center, on the edge of the circle"), Icons[2].Position.Equals(FVector2D(20.f, 100.f)));
+
+	// The icons follow the local player, the texture scrolls under them
+	LocalPlayer.Location = FVector(100.f, 0.f, 0.f);
+	Layout.Update(LocalPlayer, Teammates);
+	TestTrue(TEXT("The texture is centered on the local player"), Layout.GetTextureCenter().Equals(FVector2D(0.5f, 0.4f)));
+	TestEqual(TEXT("The circle follows the local player"), Layout.GetIcons().Num(), 4);
+	if (Layout.GetIcons().Num() != 4) return false;
+	TestTrue(TEXT("A teammate at the same location is at the center"), Layout.GetIcons()[1].Position.Equals(FVector2D(100.f, 100.f)));
+
+	// An empty area or no zoom would divide by zero
+	Layout.SetWorldBounds(FVector2D::ZeroVector, 0.f);
+	Layout.SetMapSize(200.f, 0.f);
+	const FVector2D Clamped = Layout.WorldToTexture(FVector(100.f, 100.f, 0.f));
+	TestFalse(TEXT("An empty area is clamped"), FMath::IsNaN(Clamped.X) || FMath::IsNaN(Clamped.Y));
+	TestFalse(TEXT("No zoom is clamped"), FMath::IsNaN(Layout.GetTextureExtent()));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,121 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MurphysLaw.h"
+#include "MurphysLawNameplateOverlay.h"
+#include "../Network/MurphysLawPlayerController.h"
+#include "../Network/MurphysLawPlayerState.h"
+#include "../Network/MurphysLawGameState.h"
+#include "../Character/MurphysLawCharacter.h"
+#include "Blueprint/WidgetLayoutLibrary.h"
+#include "Fonts/FontMeasure.h"
+
+DECLARE_CYCLE_STAT(TEXT("Nameplate overlay projection"), STAT_ML_NameplateProjection, STATGROUP_MurphysLaw);
+DECLARE_CYCLE_STAT(TEXT("Nameplate overlay teammates"), STAT_ML_NameplateTeammates, STATGROUP_MurphysLaw);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Nameplates drawn"), STAT_ML_NameplatesDrawn, STATGROUP_MurphysLaw);
+
+UMurphysLawNameplateOverlay::UMurphysLawNameplateOverlay(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer),
+	MaxDistance(5000.f),		// 50 meters
+	Font(FPaths::EngineContentDir() / TEXT("Slate/Fonts/Roboto-Bold.ttf"), 14),
+	Color(FLinearColor::White),
+	MyPlayerController(nullptr),
+	TeammatesVersion(INDEX_NONE)
+{}
+
+// Sets the player whose teammates are shown
+void UMurphysLawNameplateOverlay::SetPlayerController(AMurphysLawPlayerController* PlayerController)
+{
+	MyPlayerController = PlayerController;
+	TeammatesVersion = INDEX_NONE;
+}
+
+// Projects the visible teammates on the screen
+void UMurphysLawNameplateOverlay::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+	Super::NativeTick(MyGeometry, InDeltaTime);
+
+	VisibleNameplates.Reset();
+
+	AMurphysLawGameState* GameState = GetWorld() != nullptr ? GetWorld()->GetGameState<AMurphysLawGameState>() : nullptr;
+	if (MyPlayerController == nullptr || MyPlayerController->PlayerCameraManager == nullptr || GameState == nullptr) return;
+
+	if (TeammatesVersion != GameState->GetTeamAffiliationVersion())
+		UpdateTeammates(GameState->GetTeamAffiliationVersion());
+
+	if (Teammates.Num() == 0) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_ML_NameplateProjection);
+
+	int32 ViewportWidth, ViewportHeight;
+	MyPlayerController->GetViewportSize(ViewportWidth, ViewportHeight);
+	const float ViewportScale = UWidgetLayoutLibrary::GetViewportScale(this);
+	if (ViewportScale <= 0.f) return;
+
+	const FVector CameraLocation = MyPlayerController->PlayerCameraManager->GetCameraLocation();
+	const float MaxDistanceSquared = FMath::Square(MaxDistance);
+
+	for (int32 i = 0; i < Teammates.Num(); ++i)
+	{
+		const AMurphysLawCharacter* Character = Teammates[i].Character.Get();
+		if (Character == nullptr || Character->IsDead() || Character->bHidden) continue;
+
+		// Cheap distance check before the projection
+		const FVector NameplateLocation = Character->GetNameplateLocation();
+		if (FVector::DistSquared(NameplateLocation, CameraLocation) > MaxDistanceSquared) continue;
+
+		// Behind the camera or outside of the screen
+		FVector2D ScreenLocation;
+		if (!MyPlayerController->ProjectWorldLocationToScreen(NameplateLocation, ScreenLocation)) continue;
+		if (ScreenLocation.X < 0.f || ScreenLocation.Y < 0.f || ScreenLocation.X > ViewportWidth || ScreenLocation.Y > ViewportHeight) continue;
+
+		VisibleNameplate& Nameplate = VisibleNameplates[VisibleNameplates.AddUninitialized()];
+		Nameplate.TeammateIndex = i;
+
+		// Centered above the character, in the units of the widget
+		const FVector2D& NameSize = Teammates[i].NameSize;
+		Nameplate.Position = ScreenLocation / ViewportScale - FVector2D(NameSize.X * 0.5f, NameSize.Y);
+	}
+
+	INC_DWORD_STAT_BY(STAT_ML_NameplatesDrawn, VisibleNameplates.Num());
+}
+
+// Draws the names of the visible teammates
+int32 UMurphysLawNameplateOverlay::NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyClippingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	LayerId = Super::NativePaint(Args, AllottedGeometry, MyClippingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+
+	const FLinearColor TintedColor = Color * InWidgetStyle.GetColorAndOpacityTint();
+	for (const VisibleNameplate& Nameplate : VisibleNameplates)
+	{
+		const Teammate& Owner = Teammates[Nameplate.TeammateIndex];
+		FSlateDrawElement::MakeText(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(Nameplate.Position, Owner.NameSize), Owner.Name, Font, MyClippingRect, ESlateDrawEffect::None, TintedColor);
+	}
+
+	return LayerId;
+}
+
+// Recomputes the teammates of the local player and measures their names
+void UMurphysLawNameplateOverlay::UpdateTeammates(int32 TeamAffiliationVersion)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ML_NameplateTeammates);
+
+	TeammatesVersion = TeamAffiliationVersion;
+	Teammates.Reset();
+
+	const AMurphysLawPlayerState* MyPlayerState = Cast<AMurphysLawPlayerState>(MyPlayerController->PlayerState);
+	if (MyPlayerState == nullptr || MyPlayerState->GetTeam() < 0) return;
+
+	const TSharedRef<FSlateFontMeasure> FontMeasure = FSlateApplication::Get().GetRenderer()->GetFontMeasureService();
+
+	for (TActorIterator<AMurphysLawCharacter> It(GetWorld()); It; ++It)
+	{
+		const AMurphysLawPlayerState* PlayerState = Cast<AMurphysLawPlayerState>(It->PlayerState);
+		if (*It == MyPlayerController->GetPawn() || PlayerState == nullptr || PlayerState == MyPlayerState) continue;
+		if (PlayerState->GetTeam() != MyPlayerState->GetTeam()) continue;
+
+		Teammate& NewTeammate = Teammates[Teammates.AddDefaulted()];
+		NewTeammate.Character = *It;
+		NewTeammate.Name = PlayerState->GetHumanReadableName();
+		NewTeammate.NameSize = FontMeasure->Measure(NewTeammate.Name, Font);
+	}
+}
@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Blueprint/UserWidget.h"
+#include "MurphysLawNameplateOverlay.generated.h"
+
+/**
+ * Screen-space layer drawing the names of the visible teammates of the local player.
+ * The teammates and their names are only recomputed when the game state reports that
+ * the teams changed, the positions are projected once per frame and drawn in a single paint.
+ */
+UCLASS()
+class MURPHYSLAW_API UMurphysLawNameplateOverlay : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	UMurphysLawNameplateOverlay(const FObjectInitializer& ObjectInitializer);
+
+	/** Sets the player whose teammates are shown */
+	void SetPlayerController(class AMurphysLawPlayerController* PlayerController);
+
+	/** Projects the visible teammates on the screen */
+	void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+
+	/** Draws the names of the visible teammates */
+	int32 NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyClippingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+protected:
+	/** Distance beyond which the names are not drawn */
+	UPROPERTY(EditDefaultsOnly, Category = "Nameplate")
+	float MaxDistance;
+
+	/** Font of the names */
+	UPROPERTY(EditDefaultsOnly, Category = "Nameplate")
+	FSlateFontInfo Font;
+
+	/** Color of the names */
+	UPROPERTY(EditDefaultsOnly, Category = "Nameplate")
+	FLinearColor Color;
+
+private:
+	/** A teammate of the local player with its cached name */
+	struct Teammate
+	{
+		TWeakObjectPtr<class AMurphysLawCharacter> Character;
+		FString Name;
+		FVector2D NameSize;
+	};
+
+	/** A name to draw this frame */
+	struct VisibleNameplate
+	{
+		int32 TeammateIndex;
+		FVector2D Position;
+	};
+
+	/** The player whose teammates are shown */
+	UPROPERTY()
+	class AMurphysLawPlayerController* MyPlayerController;
+
+	/** The teammates of the local player */
+	TArray<Teammate> Teammates;
+
+	/** The names to draw this frame, in widget space */
+	TArray<VisibleNameplate> VisibleNameplates;
+
+	/** Version of the teams the teammates were computed from */
+	int32 TeammatesVersion;
+
+	/** Recomputes the teammates of the local player and measures their names */
+	void UpdateTeammates(int32 TeamAffiliationVersion);
+};
@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MurphysLaw.h"
+#include "MurphysLawScoreboardModel.h"
+#include "../Network/MurphysLawPlayerState.h"
+
+DECLARE_CYCLE_STAT(TEXT("Scoreboard rebuild"), STAT_ML_ScoreboardRebuild, STATGROUP_MurphysLaw);
+
+const int32 MurphysLawScoreboardModel::EXPECTED_MAX_PLAYERS(64);
+
+MurphysLawScoreboardModel::MurphysLawScoreboardModel()
+	: NumberOfTeams(0), Version(0), IsDirty(true)
+{
+	Rows.Reserve(EXPECTED_MAX_PLAYERS);
+}
+
+// Asks for the rows to be rebuilt the next time they are needed
+void MurphysLawScoreboardModel::MarkDirty()
+{
+	IsDirty = true;
+}
+
+// Rebuilds the rows from the player states if they changed
+void MurphysLawScoreboardModel::Update(const TArray<APlayerState*>& PlayerArray)
+{
+	if (!IsDirty) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_ML_ScoreboardRebuild);
+
+	IsDirty = false;
+	++Version;
+
+	// Keep the allocated rows from one rebuild to the other
+	Rows.Reset();
+	NumberOfTeams = 0;
+
+	for (APlayerState* It : PlayerArray)
+	{
+		const AMurphysLawPlayerState* PlayerState = Cast<AMurphysLawPlayerState>(It);
+		if (PlayerState == nullptr)
+		{
+			ShowError(TEXT("Unable to cast player state to AMurphysLawPlayerState"));
+			continue;
+		}
+
+		if (!PlayerState->IsActive() || PlayerState->GetTeam() < 0) continue;
+
+		Row& NewRow = Rows[Rows.AddDefaulted()];
+		NewRow.PlayerState = PlayerState;
+		NewRow.Team = PlayerState->GetTeam();
+		NewRow.NbKills = PlayerState->GetNbKills();
+		NewRow.NbDeaths = PlayerState->GetNbDeaths();
+		NewRow.Line = FString::Printf(TEXT("%s    NbKills: %d    NbDeaths: %d\n"), *PlayerState->GetHumanReadableName(), NewRow.NbKills, NewRow.NbDeaths);
+
+		NumberOfTeams = FMath::Max(NumberOfTeams, NewRow.Team + 1);
+	}
+
+	// By team, then the best players first
+	Rows.Sort([](const Row& A, const Row& B)
+	{
+		if (A.Team != B.Team) return A.Team < B.Team;
+		if (A.NbKills != B.NbKills) return A.NbKills > B.NbKills;
+		return A.NbDeaths < B.NbDeaths;
+	});
+}
+
+// Reports the sorted rows
+const TArray<MurphysLawScoreboardModel::Row>& MurphysLawScoreboardModel::GetRows() const { return Rows; }
+
+// Reports the number of teams having at least one row
+int32 MurphysLawScoreboardModel::GetNumberOfTeams() const { return NumberOfTeams; }
+
+// Reports a number that changes each time the rows are rebuilt
+int32 MurphysLawScoreboardModel::GetVersion() const { return Version; }
@@ -0,0 +1,58 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+/**
+ * Sorted rows of the scoreboard, rebuilt only when a player's team, activity, name,
+ * kills or deaths change instead of every frame the scoreboard is shown.
+ * The rows are sorted by team, then by kills and deaths.
+ */
+class MURPHYSLAW_API MurphysLawScoreboardModel
+{
+public:
+	/** A player shown on the scoreboard */
+	struct Row
+	{
+		const class AMurphysLawPlayerState* PlayerState;
+		int32 Team;
+		int32 NbKills;
+		int32 NbDeaths;
+
+		/** The formatted name, kills and deaths of the player */
+		FString Line;
+	};
+
+private:
+	/** Number of players reserved for the rows */
+	static const int32 EXPECTED_MAX_PLAYERS;
+
+	/** The active players, sorted */
+	TArray<Row> Rows;
+
+	/** The number of teams having at least one row */
+	int32 NumberOfTeams;
+
+	/** Incremented each time the rows are rebuilt */
+	int32 Version;
+
+	/** Indicates if the rows have to be rebuilt */
+	bool IsDirty;
+
+public:
+	MurphysLawScoreboardModel();
+
+	/** Asks for the rows to be rebuilt the next time they are needed */
+	void MarkDirty();
+
+	/** Rebuilds the rows from the player states if they changed */
+	void Update(const TArray<class APlayerState*>& PlayerArray);
+
+	/** Reports the sorted rows */
+	const TArray<Row>& GetRows() const;
+
+	/** Reports the number of teams having at least one row */
+	int32 GetNumberOfTeams() const;
+
+	/** Reports a number that changes each time the rows are rebuilt */
+	int32 GetVersion() const;
+};
@@ -28,56 +28,61 @@ void UMurphysLawScoreboardWidget::SetPlayerController(AMurphysLawPlayerControlle
 // Generates the data of Team A for the Scoreboard
 FText UMurphysLawScoreboardWidget::GetTeamAData() const
 {
-	AMurphysLawGameState* GameState = Cast<AMurphysLawGameState>(GetWorld()->GetGameState());
-	if (GameState)
-		return FText::FromString(FString::Printf(TEXT("---------- TEAM A Score : %d ----------\n"), GameState->ScoreTeamA) +
-			GetScoreboardData(AMurphysLawGameMode::TEAM_A));
-	else
-		return FText();
+	return GetTeamData(AMurphysLawGameMode::TEAM_A);
 }
 
-// Generates the data of Team A for the Scoreboard
+// Generates the data of Team B for the Scoreboard
 FText UMurphysLawScoreboardWidget::GetTeamBData() const
 {
-	AMurphysLawGameState* GameState = Cast<AMurphysLawGameState>(GetWorld()->GetGameState());
-	if (GameState)
-		return FText::FromString(FString::Printf(TEXT("---------- TEAM B Score : %d ----------\n"), GameState->ScoreTeamB) +
-			GetScoreboardData(AMurphysLawGameMode::TEAM_B));
-	else
-		return FText();
+	return GetTeamData(AMurphysLawGameMode::TEAM_B);
+}
+
+// Generates the data of any team for the Scoreboard
+FText UMurphysLawScoreboardWidget::GetTeamData(int32 Team) const
+{
+	// The bindings are evaluated every frame, the texts are only rebuilt when the scoreboard changes
+	UpdateTeamTexts();
+	return TeamTexts.IsValidIndex(Team) ? TeamTexts[Team] : FText::GetEmpty();
 }
 
-// Generates the text for the Scoreboard
-FString UMurphysLawScoreboardWidget::GetScoreboardData(int32 NoTeam) const
+// Rebuilds the text of each team when the scoreboard model has changed
+void UMurphysLawScoreboardWidget::UpdateTeamTexts() const
 {
-	AGameState* GameState = GetWorld()->GetGameState();
-	FString Result = "";
+	AMurphysLawGameState* GameState = Cast<AMurphysLawGameState>(GetWorld()->GetGameState());
+	if (GameState == nullptr)
+	{
+		TeamTexts.Reset();
+		TeamTextsVersion = INDEX_NONE;
+		return;
+	}
+
+	const MurphysLawScoreboardModel& Scoreboard = GameState->GetScoreboard();
+	const APlayerState* LocalPlayerState = MyPlayerController != nullptr ? MyPlayerController->PlayerState : nullptr;
+	if (Scoreboard.GetVersion() == TeamTextsVersion && LocalPlayerState == TeamTextsPlayerState) return;
 
-	if (GameState != nullptr)
+	TeamTextsVersion = Scoreboard.GetVersion();
+	TeamTextsPlayerState = LocalPlayerState;
+
+	// Both teams are always shown, even when empty
+	const int32 NumberOfTeams = FMath::Max<int32>(Scoreboard.GetNumberOfTeams(), AMurphysLawGameMode::TEAM_B + 1);
+	TArray<FString> Texts;
+	Texts.SetNum(NumberOfTeams);
+	for (int32 Team = 0; Team < NumberOfTeams; ++Team)
 	{
-		// Loops through all the players and calculates their stats
-		for (APlayerState* It : GameState->PlayerArray)
-		{
-			AMurphysLawPlayerState* PlayerState = Cast<AMurphysLawPlayerState>(It);
-			if (PlayerState != nullptr && PlayerState->GetTeam() == NoTeam && PlayerState->IsActive())
-			{
-				Result += (MyPlayerController && MyPlayerController->PlayerState == It ? TEXT("* ") : TEXT("  "));
-				Result += PlayerState->GetHumanReadableName() + TEXT("    NbKills: ") + FString::FromInt(PlayerState->GetNbKills());
-				Result += TEXT("    NbDeaths: ") + FString::FromInt(PlayerState->GetNbDeaths());
-				Result += TEXT("\n");
-			}
-			else if (PlayerState == nullptr)
-			{
-				ShowError(TEXT("Unable to cast player state to AMurphysLawPlayerState"));
-			}
-		}
+		Texts[Team] = FString::Printf(TEXT("---------- TEAM %c Score : %d ----------\n"), TEXT('A') + Team, GameState->GetTeamScore(Team));
 	}
-	else
+
+	for (const MurphysLawScoreboardModel::Row& Row : Scoreboard.GetRows())
 	{
-		ShowError(TEXT("Unable to show the list of player in the game"));
+		Texts[Row.Team] += Row.PlayerState == LocalPlayerState ? TEXT("* ") : TEXT("  ");
+		Texts[Row.Team] += Row.Line;
 	}
 
-	return Result;
+	TeamTexts.SetNum(NumberOfTeams);
+	for (int32 Team = 0; Team < NumberOfTeams; ++Team)
+	{
+		TeamTexts[Team] = FText::FromString(Texts[Team]);
+	}
 }
 
 // Reports the Scoreboard visibility
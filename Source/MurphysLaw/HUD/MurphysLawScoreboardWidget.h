@@ -42,19 +42,32 @@ protected:
 	UFUNCTION(BlueprintPure, Category = "Scoreboard")
 	FText GetTeamAData() const;
 
-	/** Generates the data of Team A for the Scoreboard */
+	/** Generates the data of Team B for the Scoreboard */
 	UFUNCTION(BlueprintPure, Category = "Scoreboard")
 	FText GetTeamBData() const;
 
+	/** Generates the data of any team for the Scoreboard */
+	UFUNCTION(BlueprintPure, Category = "Scoreboard")
+	FText GetTeamData(int32 Team) const;
+
 	/** Generates the data of Team A for the Scoreboard */
 	UFUNCTION(BlueprintPure, Category = "Scoreboard")
 	FString GetWinningTeam() const;
 
 private:
-	/** Generates the data of a team for the Scoreboard */
-	FString GetScoreboardData(int32 NoTeam) const;
+	/** Rebuilds the text of each team when the scoreboard model has changed */
+	void UpdateTeamTexts() const;
 
 	/** Tells whether the scoreboard is shown or not */
 	bool IsScoreboardVisible;
+
+	/** The text of each team, shown as is by the bindings */
+	mutable TArray<FText> TeamTexts;
+
+	/** Version of the scoreboard model the texts were built from */
+	mutable int32 TeamTextsVersion = INDEX_NONE;
+
+	/** Player state highlighted in the texts */
+	mutable const APlayerState* TeamTextsPlayerState = nullptr;
 	
 };
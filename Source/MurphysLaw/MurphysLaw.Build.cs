@@ -6,7 +6,7 @@ public class MurphysLaw : ModuleRules
 {
 	public MurphysLaw(TargetInfo Target)
 	{
-		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "UMG", "OnlineSubsystem", "OnlineSubsystemUtils" });
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "UMG", "AIModule", "OnlineSubsystem", "OnlineSubsystemUtils" });
 		DynamicallyLoadedModuleNames.Add("OnlineSubsystemNull");
 
 		PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
@@ -7,6 +7,9 @@
 #include "UnrealNetwork.h"
 #include "Online.h"
 
+/** Groups the game specific counters, shown with "stat MurphysLaw" */
+DECLARE_STATS_GROUP(TEXT("MurphysLaw"), STATGROUP_MurphysLaw, STATCAT_Advanced);
+
 void ShowInfo(const char* c, const float DisplayTime = 5.f);
 void ShowInfo(const FString& s, const float DisplayTime = 5.f);
 
@@ -6,11 +6,43 @@
 #include "Blueprint/UserWidget.h"
 #include "Network/MurphysLawGameMode.h"
 
-#define SETTING_SERVERNAME FName(TEXT("SERVERNAME"))
+DEFINE_LOG_CATEGORY_STATIC(ML_Travel, Log, All);
+
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Join to playable (s)"), STAT_ML_JoinToPlayable, STATGROUP_MurphysLaw);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Match assets preload (s)"), STAT_ML_MatchAssetsPreload, STATGROUP_MurphysLaw);
+
+static TAutoConsoleVariable<int32> CVarPreloadMatchAssets(
+	TEXT("MurphysLaw.Travel.PreloadMatchAssets"),
+	1,
+	TEXT("Loads the match assets in the background from the menu and keeps them loaded between the matches,\n")
+	TEXT("instead of loading them with the match map."));
+
+static TAutoConsoleVariable<int32> CVarMaxSearchResults(
+	TEXT("MurphysLaw.ServerBrowser.MaxSearchResults"),
+	100,
+	TEXT("Maximum number of sessions reported by a search of the server browser."));
+
+const float UMurphysLawGameInstance::SEARCH_POLL_INTERVAL(0.1f);
 
 UMurphysLawGameInstance::UMurphysLawGameInstance(const FObjectInitializer& ObjectInitializer)
-	: Super(ObjectInitializer)
+	: Super(ObjectInitializer), PreloadStartTime(-1.0), TravelStartTime(-1.0), IsSeamlessTravel(false)
 {
+	// The character, its weapons, the HUD widgets and the sounds heard as soon as the match starts
+	MatchAssets.Add(FStringAssetReference(TEXT("/Game/MurphysLaw/Visual/Characters/Cowboy1/Partial/BP_Cowboy1_arms.BP_Cowboy1_arms_C")));
+	MatchAssets.Add(FStringAssetReference(TEXT("/Game/MurphysLaw/Weapons/BP_Pistol.BP_Pistol_C")));
+	MatchAssets.Add(FStringAssetReference(TEXT("/Game/MurphysLaw/Weapons/BP_Rifle.BP_Rifle_C")));
+	MatchAssets.Add(FStringAssetReference(TEXT("/Game/MurphysLaw/Weapons/BP_Shotgun.BP_Shotgun_C")));
+	MatchAssets.Add(FStringAssetReference(TEXT("/Game/MurphysLaw/HUD/BP_HUD.BP_HUD_C")));
+	MatchAssets.Add(FStringAssetReference(TEXT("/Game/MurphysLaw/HUD/BP_Scoreboard.BP_Scoreboard_C")));
+	MatchAssets.Add(FStringAssetReference(TEXT("/Game/MurphysLaw/Menu/BP_InGameMenu.BP_InGameMenu_C")));
+	MatchAssets.Add(FStringAssetReference(TEXT("/Game/MurphysLawRessources/Weapons/S_Gun_Fire.S_Gun_Fire")));
+	MatchAssets.Add(FStringAssetReference(TEXT("/Game/MurphysLawRessources/Weapons/S_Gun_Dry.S_Gun_Dry")));
+	MatchAssets.Add(FStringAssetReference(TEXT("/Game/MurphysLawRessources/Weapons/S_Gun_Reload.S_Gun_Reload")));
+	MatchAssets.Add(FStringAssetReference(TEXT("/Game/MurphysLawRessources/Weapons/S_Switch_Weapon.S_Switch_Weapon")));
+	MatchAssets.Add(FStringAssetReference(TEXT("/Game/MurphysLawRessources/Weapons/Pistol/Sounds/S_Pistol_Fire.S_Pistol_Fire")));
+	MatchAssets.Add(FStringAssetReference(TEXT("/Game/MurphysLawRessources/Weapons/Pistol/Sounds/S_Pistol_Dry.S_Pistol_Dry")));
+	MatchAssets.Add(FStringAssetReference(TEXT("/Game/MurphysLawRessources/SoundEffects/Explosion/S_ExplosionBlast1.S_ExplosionBlast1")));
+
 	/** Bind function for CREATING a Session */
 	OnCreateSessionCompleteDelegate = FOnCreateSessionCompleteDelegate::CreateUObject(this, &UMurphysLawGameInstance::OnCreateSessionComplete);
 	OnStartSessionCompleteDelegate = FOnStartSessionCompleteDelegate::CreateUObject(this, &UMurphysLawGameInstance::OnStartOnlineGameComplete);
@@ -24,6 +56,64 @@ UMurphysLawGameInstance::UMurphysLawGameInstance(const FObjectInitializer& Objec
 	OnDestroySessionCompleteDelegate = FOnEndSessionCompleteDelegate::CreateUObject(this, &UMurphysLawGameInstance::OnDestroySessionComplete);
 }
 
+// Starts loading the match assets while the menu is shown
+void UMurphysLawGameInstance::Init()
+{
+	Super::Init();
+	PreloadMatchAssets();
+}
+
+// Starts loading the match assets in the background, once
+void UMurphysLawGameInstance::PreloadMatchAssets()
+{
+	if (PreloadStartTime >= 0.0 || CVarPreloadMatchAssets.GetValueOnGameThread() == 0) return;
+
+	// A dedicated server shows no HUD and plays no sound, the game mode loads the character class it needs
+	if (IsRunningDedicatedServer()) return;
+
+	PreloadStartTime = FPlatformTime::Seconds();
+	AssetStreamer.RequestAsyncLoad(StaticClass(), MatchAssets, FStreamableDelegate::CreateUObject(this, &UMurphysLawGameInstance::OnMatchAssetsLoaded));
+}
+
+// Keeps the match assets loaded across the map changes
+void UMurphysLawGameInstance::OnMatchAssetsLoaded()
+{
+	LoadedMatchAssets.Reset();
+	for (const FStringAssetReference& Asset : MatchAssets)
+	{
+		UObject* Object = Asset.ResolveObject();
+		if (Object != nullptr) LoadedMatchAssets.Add(Object);
+	}
+
+	const float PreloadTime = static_cast<float>(FPlatformTime::Seconds() - PreloadStartTime);
+	SET_FLOAT_STAT(STAT_ML_MatchAssetsPreload, PreloadTime);
+	UE_LOG(ML_Travel, Log, TEXT("%d of %d match assets loaded in the background in %.2f s"), LoadedMatchAssets.Num(), MatchAssets.Num(), PreloadTime);
+}
+
+// Starts measuring the time until the local player can play, and loads the match assets if it was not done
+void UMurphysLawGameInstance::BeginMatchTravel(bool IsSeamless)
+{
+	TravelStartTime = FPlatformTime::Seconds();
+	IsSeamlessTravel = IsSeamless;
+	PreloadMatchAssets();
+}
+
+// Reports the time since the travel started, once the local player controls its character
+void UMurphysLawGameInstance::EndMatchTravel()
+{
+	if (TravelStartTime < 0.0) return;
+
+	const float JoinToPlayable = static_cast<float>(FPlatformTime::Seconds() - TravelStartTime);
+	TravelStartTime = -1.0;
+
+	SET_FLOAT_STAT(STAT_ML_JoinToPlayable, JoinToPlayable);
+	UE_LOG(ML_Travel, Log, TEXT("Join to playable: %.2f s (seamless travel: %s, match assets preloaded: %s)"), JoinToPlayable,
+		IsSeamlessTravel ? TEXT("yes") : TEXT("no"), LoadedMatchAssets.Num() > 0 ? TEXT("yes") : TEXT("no"));
+}
+
+// Loads the assets referenced softly by the classes of the game
+MurphysLawAssetStreamer& UMurphysLawGameInstance::GetAssetStreamer() { return AssetStreamer; }
+
 bool UMurphysLawGameInstance::HostSession(TSharedPtr<const FUniqueNetId> UserId, bool bIsLAN, bool bIsPresence)
 {
 	// Get the Online Subsystem to work with
@@ -55,7 +145,7 @@ bool UMurphysLawGameInstance::HostSession(TSharedPtr<const FUniqueNetId> UserId,
 			SessionSettings->bAllowJoinViaPresenceFriendsOnly = false;
 
 			
-			SessionSettings->Set(SETTING_SERVERNAME, FString(GameSettings.GameName), EOnlineDataAdvertisementType::ViaOnlineService);
+			SessionSettings->Set(MurphysLawServerBrowser::SETTING_SERVERNAME, FString(GameSettings.GameName), EOnlineDataAdvertisementType::ViaOnlineService);
 			SessionSettings->Set(SETTING_MAPNAME, FString("Default"), EOnlineDataAdvertisementType::ViaOnlineService);
 
 			// Set the delegate to the Handle of the SessionInterface
@@ -173,7 +263,7 @@ void UMurphysLawGameInstance::FindSessions(TSharedPtr<const FUniqueNetId> UserId
 			SessionSearch = MakeShareable(new FOnlineSessionSearch());
 
 			SessionSearch->bIsLanQuery = true;
-			SessionSearch->MaxSearchResults = 20;
+			SessionSearch->MaxSearchResults = FMath::Max(CVarMaxSearchResults.GetValueOnGameThread(), 1);
 			SessionSearch->PingBucketSize = 50;
 
 			// We only want to set this Query Setting if "bIsPresence" is true
@@ -187,6 +277,10 @@ void UMurphysLawGameInstance::FindSessions(TSharedPtr<const FUniqueNetId> UserId
 			// Set the Delegate to the Delegate Handle of the FindSession function
 			OnFindSessionsCompleteDelegateHandle = Sessions->AddOnFindSessionsCompleteDelegate_Handle(OnFindSessionsCompleteDelegate);
 
+			// The LAN search adds the results as the servers answer, they are merged in the list without waiting for the end of the search
+			ServerBrowser.BeginSearch();
+			GetTimerManager().SetTimer(TimerHandle_PollSessionSearch, this, &UMurphysLawGameInstance::PollSessionSearch, SEARCH_POLL_INTERVAL, true);
+
 			// Finally call the SessionInterface function. The Delegate gets called once this is finished
 			Sessions->FindSessions(*UserId, SearchSettingsRef);
 		}
@@ -210,50 +304,36 @@ void UMurphysLawGameInstance::OnFindSessionsComplete(bool bWasSuccessful)
 		{
 			// Clear the Delegate handle, since we finished this call
 			Sessions->ClearOnFindSessionsCompleteDelegate_Handle(OnFindSessionsCompleteDelegateHandle);
-
-			// If we have found at least 1 session, we just going to debug them. You could add them to a list of UMG Widgets, like it is done in the BP version!
-			if (SessionSearch->SearchResults.Num() > 0)
-			{
-				// "SessionSearch->SearchResults" is an Array that contains all the information. You can access the Session in this and get a lot of information.
-				// This can be customized later on with your own classes to add more information that can be set and displayed
-				for (int32 SearchIdx = 0; SearchIdx < SessionSearch->SearchResults.Num(); SearchIdx++)
-				{
-					FString MapName;
-					SessionSearch->SearchResults[SearchIdx].Session.SessionSettings.Get(SETTING_MAPNAME, MapName);
-					// OwningUserName is just the GameSessionName for now. I guess you can create your own Host Settings class and GameSession Class and add a proper GameServer Name here.
-					// This is something you can't do in Blueprint for example!
-					// Default name: *(SessionSearch->SearchResults[SearchIdx].Session.OwningUserName)
-					
-					const FOnlineSessionSearchResult& Result = SessionSearch->SearchResults[SearchIdx];
-					int32 CurrentPlayers = Result.Session.SessionSettings.NumPublicConnections
-						+ Result.Session.SessionSettings.NumPrivateConnections
-						- Result.Session.NumOpenPublicConnections
-						- Result.Session.NumOpenPrivateConnections;
-
-					if (CurrentPlayers != 0)
-					{
-						FServerEntry ServerEntry;
-						FString ServerName;
-						FString MapName;
-						Result.Session.SessionSettings.Get(SETTING_SERVERNAME, ServerName);
-						Result.Session.SessionSettings.Get(SETTING_MAPNAME, MapName);
-						ServerEntry.ServerName = ServerName == "" ? Result.Session.OwningUserName : ServerName;
-						ServerEntry.MapName = MapName;
-						ServerEntry.GameType = "";
-						ServerEntry.CurrentPlayers = FString::FromInt(CurrentPlayers);
-						ServerEntry.MaxPlayers = FString::FromInt(Result.Session.SessionSettings.NumPublicConnections
-							+ Result.Session.SessionSettings.NumPrivateConnections);
-						ServerEntry.Ping = FString::FromInt(Result.PingInMs);
-						ServerEntry.SearchResultsIndex = SearchIdx;
-						ServerEntries.Add(ServerEntry);
-					}
-				}
-			}
 		}
 	}
+
+	GetTimerManager().ClearTimer(TimerHandle_PollSessionSearch);
+
+	// The known sessions not seen by this search are kept until they expire
+	MergeSearchResults();
 	this->OnSessionFindCompleted();
 }
 
+// Merges the results received since the last poll of the running search
+void UMurphysLawGameInstance::PollSessionSearch()
+{
+	if (MergeSearchResults())
+		this->OnServerListChanged();
+}
+
+// Merges the results of the running search in the server list, returns true if the list changed
+bool UMurphysLawGameInstance::MergeSearchResults()
+{
+	const float Time = static_cast<float>(FPlatformTime::Seconds());
+	bool HasChanged = ServerBrowser.Expire(Time);
+	if (SessionSearch.IsValid())
+		HasChanged |= ServerBrowser.Merge(SessionSearch->SearchResults, Time);
+
+	if (HasChanged)
+		ServerBrowser.GetEntries(ServerEntries);
+	return HasChanged;
+}
+
 void UMurphysLawGameInstance::CancelFindOnlineGames()
 {
 	// Get OnlineSubsystem we want to work with
@@ -267,6 +347,8 @@ void UMurphysLawGameInstance::CancelFindOnlineGames()
 			Sessions->ClearOnFindSessionsCompleteDelegate_Handle(OnFindSessionsCompleteDelegateHandle);
 		}
 	}
+
+	GetTimerManager().ClearTimer(TimerHandle_PollSessionSearch);
 }
 
 bool UMurphysLawGameInstance::JoinASession(TSharedPtr<const FUniqueNetId> UserId, FName GameSessionName, const FOnlineSessionSearchResult& SearchResult)
@@ -364,6 +446,8 @@ void UMurphysLawGameInstance::StartOnlineGame(FString GameName, FString GameLeng
 	GameSettings.NbPlayersPerTeam = NumPlayers;
 	GameSettings.WarmupWanted = WarmupWanted;
 
+	BeginMatchTravel(false);
+
 	// Creating a local player where we can get the UserID from
 	ULocalPlayer* const Player = GetFirstGamePlayer();
 
@@ -371,13 +455,29 @@ void UMurphysLawGameInstance::StartOnlineGame(FString GameName, FString GameLeng
 	HostSession(Player->GetPreferredUniqueNetId(), true, true);
 }
 
+// Searches the servers, asked by the player so the new servers show up right away
 void UMurphysLawGameInstance::FindOnlineGames()
 {
+	// A search is already merging its results in the list
+	if (GetTimerManager().IsTimerActive(TimerHandle_PollSessionSearch)) return;
+
 	ULocalPlayer* const Player = GetFirstGamePlayer();
-	ServerEntries.Empty();
 	FindSessions(Player->GetPreferredUniqueNetId(), GameSessionName, true, true);
 }
 
+// Searches the servers only once a known server is stale, for the periodic refresh of the list
+void UMurphysLawGameInstance::RefreshOnlineGames()
+{
+	// The list is kept between two searches
+	if (!ServerBrowser.NeedsRefresh(static_cast<float>(FPlatformTime::Seconds())))
+	{
+		this->OnSessionFindCompleted();
+		return;
+	}
+
+	FindOnlineGames();
+}
+
 void UMurphysLawGameInstance::JoinOnlineGame(int32 SessionIndex)
 {
 	ULocalPlayer* const Player = GetFirstGamePlayer();
@@ -385,15 +485,17 @@ void UMurphysLawGameInstance::JoinOnlineGame(int32 SessionIndex)
 	// Just a SearchResult where we can save the one we want to use, for the case we find more than one!
 	FOnlineSessionSearchResult SearchResult;
 
-	// If the Array is not empty, we can go through it
-	if (SessionSearch->SearchResults.Num() > 0)
+	// The index is the key of an entry of the server list, the session may have expired since the list was shown
+	const FOnlineSessionSearchResult* KnownResult = ServerBrowser.GetResult(SessionIndex);
+	if (KnownResult != nullptr)
 	{
 		//for (int32 i = 0; i < SessionSearch->SearchResults.Num(); i++)
 		//{
 			// To avoid something crazy, we filter sessions from ourself
-			if (SessionSearch->SearchResults[SessionIndex].Session.OwningUserId != Player->GetPreferredUniqueNetId())
+			if (KnownResult->Session.OwningUserId != Player->GetPreferredUniqueNetId())
 			{
-				SearchResult = SessionSearch->SearchResults[SessionIndex];
+				SearchResult = *KnownResult;
+				BeginMatchTravel(false);
 
 				// Once we found sounce a Session that is not ours, just join it. Instead of using a for loop, you could
 				// use a widget where you click on and have a reference for the GameSession it represents which you can use
@@ -405,6 +507,38 @@ void UMurphysLawGameInstance::JoinOnlineGame(int32 SessionIndex)
 	}
 }
 
+// Joins the least loaded known server having a free slot, returns false if there is none
+bool UMurphysLawGameInstance::QuickJoinOnlineGame()
+{
+	const int32 BestSession = ServerBrowser.GetBestSession();
+	if (BestSession == INDEX_NONE) return false;
+
+	JoinOnlineGame(BestSession);
+	return true;
+}
+
+// Advertises the number of players and the frame time of the hosted session
+void UMurphysLawGameInstance::AdvertiseServerLoad(int32 NumPlayers, float ServerFrameTime)
+{
+	// Only the game instance that created the session has its settings
+	if (!SessionSettings.IsValid()) return;
+
+	IOnlineSubsystem* OnlineSub = IOnlineSubsystem::Get();
+	if (OnlineSub)
+	{
+		IOnlineSessionPtr Sessions = OnlineSub->GetSessionInterface();
+
+		if (Sessions.IsValid() && Sessions->GetNamedSession(GameSessionName) != nullptr)
+		{
+			SessionSettings->Set(MurphysLawServerBrowser::SETTING_PLAYERCOUNT, NumPlayers, EOnlineDataAdvertisementType::ViaOnlineService);
+			SessionSettings->Set(MurphysLawServerBrowser::SETTING_SERVERFRAMETIME, ServerFrameTime, EOnlineDataAdvertisementType::ViaOnlineService);
+
+			// The LAN beacon answers the searches with the settings of the named session
+			Sessions->UpdateSession(GameSessionName, *SessionSettings, false);
+		}
+	}
+}
+
 void UMurphysLawGameInstance::DestroySessionAndLeaveGame()
 {
 	IOnlineSubsystem* OnlineSub = IOnlineSubsystem::Get();
@@ -4,6 +4,8 @@
 
 #include "Engine/GameInstance.h"
 #include "Settings/MurphysLawGameSettings.h"
+#include "Network/MurphysLawServerBrowser.h"
+#include "Utils/MurphysLawAssetStreamer.h"
 #include "MurphysLawGameInstance.generated.h"
 
 USTRUCT(BlueprintType)
@@ -25,6 +27,14 @@ struct FServerEntry
 	FString Ping;
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ServerList")
 	int32 SearchResultsIndex;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ServerList")
+	int32 PingInMs;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ServerList")
+	float ServerFrameTime;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ServerList")
+	float Load;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ServerList")
+	bool IsFull;
 };
 
 /**
@@ -43,9 +53,39 @@ public:
 
 	FString PlayerName;
 
+	/** Assets needed as soon as a match starts, loaded in the background from the menu and kept for every match.
+		The blueprint of the game instance can add more. */
+	UPROPERTY(EditDefaultsOnly, Category = "Travel")
+	TArray<FStringAssetReference> MatchAssets;
+
 private:
+	/** Number of seconds between two merges of the results of a running search */
+	static const float SEARCH_POLL_INTERVAL;
+
 	MurphysLawGameSettings GameSettings;
 
+	/** Sessions found by the previous searches */
+	MurphysLawServerBrowser ServerBrowser;
+
+	/** Handle for the merges of the results of a running search */
+	FTimerHandle TimerHandle_PollSessionSearch;
+
+	/** Loads the assets referenced softly by the classes of the game */
+	MurphysLawAssetStreamer AssetStreamer;
+
+	/** The loaded match assets, referenced to survive the map changes */
+	UPROPERTY()
+	TArray<UObject*> LoadedMatchAssets;
+
+	/** Time at which the loading of the match assets was requested, negative if it was not */
+	double PreloadStartTime;
+
+	/** Time at which the player started to join or host a match, negative if not travelling */
+	double TravelStartTime;
+
+	/** Indicates if the current travel keeps the player connected */
+	bool IsSeamlessTravel;
+
 #pragma region Pointers
 	TSharedPtr<class FOnlineSessionSettings> SessionSettings;
 	TSharedPtr<class FOnlineSessionSearch> SessionSearch;
@@ -128,6 +168,12 @@ private:
 	*/
 	void OnFindSessionsComplete(bool bWasSuccessful);
 
+	/** Merges the results received since the last poll of the running search */
+	void PollSessionSearch();
+
+	/** Merges the results of the running search in the server list, returns true if the list changed */
+	bool MergeSearchResults();
+
 	/**
 	*	Joins a session via a search result
 	*
@@ -154,20 +200,49 @@ private:
 	*/
 	virtual void OnDestroySessionComplete(FName SessionName, bool bWasSuccessful);
 
+	/** Starts loading the match assets in the background, once */
+	void PreloadMatchAssets();
+
+	/** Keeps the match assets loaded across the map changes */
+	void OnMatchAssetsLoaded();
+
 public:
+	/** Starts loading the match assets while the menu is shown */
+	virtual void Init() override;
+
+	/** Starts measuring the time until the local player can play, and loads the match assets if it was not done */
+	void BeginMatchTravel(bool IsSeamless);
+
+	/** Reports the time since the travel started, once the local player controls its character */
+	void EndMatchTravel();
+
+	/** Loads the assets referenced softly by the classes of the game */
+	MurphysLawAssetStreamer& GetAssetStreamer();
 
 	UFUNCTION(BlueprintCallable, Category = "Network")
 	void StartOnlineGame(FString GameName, FString GameLength, int32 WinningScore, int32 NumPlayers, bool WarmupWanted);
 
+	/** Searches the servers, asked by the player so the new servers show up right away */
 	UFUNCTION(BlueprintCallable, Category = "Network")
 	void FindOnlineGames();
 
+	/** Searches the servers only once a known server is stale, for the periodic refresh of the list */
+	UFUNCTION(BlueprintCallable, Category = "Network")
+	void RefreshOnlineGames();
+
 	UFUNCTION(BlueprintCallable, Category = "Network")
 	void CancelFindOnlineGames();
 
 	UFUNCTION(BlueprintCallable, Category = "Network")
 	void JoinOnlineGame(int32 SessionIndex);
 
+	/** Joins the least loaded known server having a free slot, returns false if there is none */
+	UFUNCTION(BlueprintCallable, Category = "Network")
+	bool QuickJoinOnlineGame();
+
+	/** Advertises the number of players and the frame time of the hosted session */
+	void AdvertiseServerLoad(int32 NumPlayers, float ServerFrameTime);
+
 	UFUNCTION(BlueprintCallable, Category = "Network")
 	void DestroySessionAndLeaveGame();
 
@@ -180,6 +255,10 @@ public:
 	UFUNCTION(BlueprintImplementableEvent, meta = (CallInEditor = "true"))
 	void OnSessionFindCompleted();
 
+	/** Called each time servers are added to or updated in the server list while searching */
+	UFUNCTION(BlueprintImplementableEvent, meta = (CallInEditor = "true"))
+	void OnServerListChanged();
+
 	UFUNCTION(BlueprintImplementableEvent, meta = (CallInEditor = "true"))
 	void OnStartSessionCompleted();
 
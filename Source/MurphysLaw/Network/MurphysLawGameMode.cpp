@@ -6,23 +6,41 @@
 #include "MurphysLawPlayerController.h"
 #include "MurphysLawPlayerStart.h"
 #include "MurphysLawPlayerState.h"
+#include "MurphysLawNetDriver.h"
 #include "../MurphysLawGameInstance.h"
+#include "../Utils/MurphysLawAssetStreamer.h"
 #include <MurphysLaw/Character/MurphysLawCharacter.h>
 #include <MurphysLaw/Settings/Teams/MurphysLawTeamColor.h>
 #include <MurphysLaw/AI/MurphysLawAIController.h>
 #include <MurphysLaw/Utils/MurphysLawUtils.h>
 #include "GameFramework/Pawn.h"
+#include "AI/Navigation/NavigationSystem.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("AI moves completed"), STAT_ML_AIMovesCompleted, STATGROUP_MurphysLaw);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("AI average time to destination"), STAT_ML_AIAverageTimeToDestination, STATGROUP_MurphysLaw);
+
+static TAutoConsoleVariable<int32> CVarSeamlessTravel(
+	TEXT("MurphysLaw.Travel.Seamless"),
+	1,
+	TEXT("At the end of the scoreboard, loads the next match through the transition map with the connected players,\n")
+	TEXT("instead of destroying the session and sending everyone back to the menu."));
+
+const float AMurphysLawGameMode::RELEVANCY_GRID_REBUILD_INTERVAL(0.25f);
+const float AMurphysLawGameMode::ADVERTISE_LOAD_INTERVAL(2.f);
+const float AMurphysLawGameMode::FRAME_TIME_SMOOTHING(0.05f);
 
 AMurphysLawGameMode::AMurphysLawGameMode()
-	: Super()
+	: Super(), AverageFrameTime(0.f), NumberOfBotMovesCompleted(0), TotalBotTimeToDestination(0.f)
 {
-	// set default pawn class to our Blueprinted character
-	static ConstructorHelpers::FClassFinder<APawn> PlayerPawnClassFinder(TEXT("/Game/MurphysLaw/Visual/Characters/Cowboy1/Partial/BP_Cowboy1_arms"));
-	DefaultPawnClass = PlayerPawnClassFinder.Class;
+	// Our Blueprinted character, loaded with the match instead of with the class defaults
+	CharacterClass = TAssetSubclassOf<APawn>(FStringAssetReference(TEXT("/Game/MurphysLaw/Visual/Characters/Cowboy1/Partial/BP_Cowboy1_arms.BP_Cowboy1_arms_C")));
 		
 	GameStateClass = AMurphysLawGameState::StaticClass();
 	PlayerStateClass = AMurphysLawPlayerState::StaticClass();
 	InactivePlayerStateLifeSpan = 0.f;
+
+	// The players stay connected when the server changes map
+	bUseSeamlessTravel = true;
 }
 
 /** Initialize the game. This is called before actors' PreInitializeComponents. */
@@ -33,8 +51,95 @@ void AMurphysLawGameMode::InitGame(const FString& MapName, const FString& Option
 	// Save settings for player state access
 	GameSettings = MurphysLawGameSettings::Parse(Options);
 
+	// The characters are spawned right away, the class cannot be loaded in the background.
+	// It is already loaded when the game instance preloaded the match assets.
+	MurphysLawAssetStreamer* AssetStreamer = MurphysLawAssetStreamer::Get(GetWorld());
+	if (AssetStreamer != nullptr && !CharacterClass.IsNull() && DefaultPawnClass == ADefaultPawn::StaticClass())
+	{
+		AssetStreamer->LoadSynchronous(StaticClass(), CharacterClass.ToStringReference());
+		if (CharacterClass.Get() != nullptr)
+			DefaultPawnClass = CharacterClass.Get();
+	}
+
 	InitTeamSpawnPointsPools();
 	InitTeamCharacterPools();
+
+	// The moves of the previous match were made with its own crowd mode
+	SET_DWORD_STAT(STAT_ML_AIMovesCompleted, 0);
+	SET_FLOAT_STAT(STAT_ML_AIAverageTimeToDestination, 0.f);
+
+	// Characters move, so their cell is updated a few times per second
+	GetWorldTimerManager().SetTimer(TimerHandle_RelevancyGrid, this, &AMurphysLawGameMode::RebuildRelevancyGrid, RELEVANCY_GRID_REBUILD_INTERVAL, true);
+
+	// The server browser ranks the sessions from their player count and frame time
+	GetWorldTimerManager().SetTimer(TimerHandle_AdvertiseLoad, this, &AMurphysLawGameMode::AdvertiseLoad, ADVERTISE_LOAD_INTERVAL, true);
+}
+
+// Buckets the characters in the relevancy grid
+void AMurphysLawGameMode::RebuildRelevancyGrid()
+{
+	RelevancyGrid.Rebuild(GetWorld());
+}
+
+// Advertises the number of players and the average frame time in the session settings
+void AMurphysLawGameMode::AdvertiseLoad()
+{
+	UMurphysLawGameInstance* GameInstance = Cast<UMurphysLawGameInstance>(GetWorld()->GetGameInstance());
+	if (GameInstance)
+		GameInstance->AdvertiseServerLoad(GetNumPlayers(), AverageFrameTime * 1000.f);
+}
+
+// Decides which characters are relevant to each connection
+MurphysLawRelevancyGrid& AMurphysLawGameMode::GetRelevancyGrid() { return RelevancyGrid; }
+
+// Updates the bots, issues their line of sight traces, and applies the damage over time and the explosions
+void AMurphysLawGameMode::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	// Real frame time, unaffected by the time dilation
+	const float FrameTime = FApp::GetDeltaTime();
+	AverageFrameTime = AverageFrameTime > 0.f ? FMath::Lerp(AverageFrameTime, FrameTime, FRAME_TIME_SMOOTHING) : FrameTime;
+
+	BotBrain.Tick(GetWorld());
+	AIScheduler.Tick(GetWorld());
+	PatrolPathCache.Tick(GetWorld());
+	LineOfSightQueries.Tick(GetWorld());
+	DamageOverTime.Tick(GetWorld());
+	ExplosionQueue.Tick(GetWorld());
+}
+
+// Line of sight traces shared by the bots
+MurphysLawLineOfSightQueries& AMurphysLawGameMode::GetLineOfSightQueries() { return LineOfSightQueries; }
+
+// Updates the behavior trees of the bots under a per-frame budget
+MurphysLawAIScheduler& AMurphysLawGameMode::GetAIScheduler() { return AIScheduler; }
+
+// Decides the targets and the shots of the bots in one pass
+MurphysLawBotBrain& AMurphysLawGameMode::GetBotBrain() { return BotBrain; }
+
+// Paths between the navigation points patrolled by the bots
+MurphysLawPatrolPathCache& AMurphysLawGameMode::GetPatrolPathCache() { return PatrolPathCache; }
+
+// Applies the damage of the occupied damage zones
+MurphysLawDamageOverTime& AMurphysLawGameMode::GetDamageOverTime() { return DamageOverTime; }
+
+// Resolves the explosions over the next frames
+MurphysLawExplosionQueue& AMurphysLawGameMode::GetExplosionQueue() { return ExplosionQueue; }
+
+// Counts a bot move that reached its destination, for the average time to destination of the match
+void AMurphysLawGameMode::RecordBotMoveCompleted(float TimeToDestination)
+{
+	++NumberOfBotMovesCompleted;
+	TotalBotTimeToDestination += TimeToDestination;
+	SET_DWORD_STAT(STAT_ML_AIMovesCompleted, NumberOfBotMovesCompleted);
+	SET_FLOAT_STAT(STAT_ML_AIAverageTimeToDestination, TotalBotTimeToDestination / NumberOfBotMovesCompleted);
+}
+
+// Called when the navmesh has been rebuilt, the patrol paths are found again
+void AMurphysLawGameMode::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+	PatrolPathCache.OnNavigationRebuilt();
 }
 
 AActor* AMurphysLawGameMode::ChoosePlayerStart(int32 TeamNum)
@@ -68,9 +173,14 @@ void AMurphysLawGameMode::DefaultTimer()
 				ProcessEndGame();
 			else if (MyGameState->MurphysLawMatchState == MurphysLawMatchState::EScoreBoard)
 			{
-				UMurphysLawGameInstance* GameInstance = Cast<UMurphysLawGameInstance>(GetWorld()->GetGameInstance());
-				if (GameInstance)
-					GameInstance->DestroySessionAndLeaveGame();
+				if (CVarSeamlessTravel.GetValueOnGameThread() != 0)
+					TravelToNextMatch();
+				else
+				{
+					UMurphysLawGameInstance* GameInstance = Cast<UMurphysLawGameInstance>(GetWorld()->GetGameInstance());
+					if (GameInstance)
+						GameInstance->DestroySessionAndLeaveGame();
+				}
 			}
 		}
 	}
@@ -92,10 +202,44 @@ void AMurphysLawGameMode::ResetAllCharacters()
 	}
 }
 
+// Loads the current map again with the connected players, through the transition map
+void AMurphysLawGameMode::TravelToNextMatch()
+{
+	UMurphysLawGameInstance* GameInstance = Cast<UMurphysLawGameInstance>(GetWorld()->GetGameInstance());
+	if (GameInstance)
+		GameInstance->BeginMatchTravel(true);
+
+	GetWorld()->ServerTravel(GetWorld()->GetOutermost()->GetName() + GameSettings.Serialize());
+}
+
 void AMurphysLawGameMode::PostLogin(APlayerController* NewPlayer)
 {
 	Super::PostLogin(NewPlayer);
+	InitPlayerForMatch(NewPlayer);
+}
 
+// The players kept by the seamless travel don't log in again, they are placed like new players
+void AMurphysLawGameMode::HandleSeamlessTravelPlayer(AController*& C)
+{
+	Super::HandleSeamlessTravelPlayer(C);
+	InitPlayerForMatch(Cast<APlayerController>(C));
+}
+
+// Only the player states of the players travel, the bots of the next match get new ones
+void AMurphysLawGameMode::GetSeamlessTravelActorList(bool bToTransition, TArray<AActor*>& ActorList)
+{
+	Super::GetSeamlessTravelActorList(bToTransition, ActorList);
+
+	ActorList.RemoveAll([](const AActor* Actor)
+	{
+		const APlayerState* PlayerState = Cast<APlayerState>(Actor);
+		return PlayerState != nullptr && Cast<AAIController>(PlayerState->GetOwner()) != nullptr;
+	});
+}
+
+// Places a new player on a team, gives it a character and notifies the other players
+void AMurphysLawGameMode::InitPlayerForMatch(APlayerController* NewPlayer)
+{
 	// If there is really a new player
 	if (NewPlayer != nullptr)
 	{
@@ -105,7 +249,9 @@ void AMurphysLawGameMode::PostLogin(APlayerController* NewPlayer)
 		// If the new player state is valid
 		if (NewPlayerState != nullptr && GameState != nullptr)
 		{
-			
+			// The player states kept by the seamless travel still hold the kills and deaths of the previous match
+			NewPlayerState->ResetStats();
+
 			const int32 SelectedTeamId = GetBestTeamForNewPlayer(NewPlayer->PlayerState);
 			NewPlayerState->SetTeam(SelectedTeamId);
 			if (NewPlayer->GetPawn())
@@ -148,6 +294,13 @@ void AMurphysLawGameMode::PostLogin(APlayerController* NewPlayer)
 void AMurphysLawGameMode::HandleMatchIsWaitingToStart()
 {
 	Super::HandleMatchIsWaitingToStart();
+
+	// The navigation points don't move, their paths are found once for the whole match
+	UNavigationSystem* NavigationSystem = UNavigationSystem::GetCurrent<UNavigationSystem>(GetWorld());
+	if (NavigationSystem != nullptr)
+		NavigationSystem->OnNavigationGenerationFinishedDelegate.AddUniqueDynamic(this, &AMurphysLawGameMode::OnNavigationGenerationFinished);
+	PatrolPathCache.Build(GetWorld());
+
 	AMurphysLawGameState* const MyGameState = Cast<AMurphysLawGameState>(GameState);
 	if(MyGameState)
 		MyGameState->WinningTeam = DRAW;
@@ -206,6 +359,10 @@ void AMurphysLawGameMode::HandleMatchHasEnded()
 				PC->SetBlackboardCanMove(false);
 		}
 	}
+
+	UMurphysLawNetDriver* NetDriver = Cast<UMurphysLawNetDriver>(GetNetDriver());
+	if (NetDriver)
+		NetDriver->ExportStatsToCSV();
 }
 
 void AMurphysLawGameMode::Logout(AController* Exiting)
@@ -461,5 +618,8 @@ void AMurphysLawGameMode::UpdateMatchState(MurphysLawMatchState State, int32 Rem
 	{
 		MyGameState->MurphysLawMatchState = State;
 		MyGameState->RemainingTime = RemainingTime;
+
+		// The listen server's player has no replication to tell its HUD
+		MyGameState->OnRep_MurphysLawMatchState();
 	}
 }
\ No newline at end of file
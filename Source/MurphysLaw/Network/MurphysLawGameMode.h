@@ -3,6 +3,13 @@
 #include "GameFramework/GameMode.h"
 #include "../Settings/MurphysLawGameSettings.h"
 #include "MurphysLawGameState.h"
+#include "MurphysLawRelevancyGrid.h"
+#include "../AI/MurphysLawLineOfSightQueries.h"
+#include "../AI/MurphysLawAIScheduler.h"
+#include "../AI/MurphysLawBotBrain.h"
+#include "../AI/MurphysLawPatrolPathCache.h"
+#include "../DamageZone/MurphysLawDamageOverTime.h"
+#include "../Environnement/ExplosiveBarrel/MurphysLawExplosionQueue.h"
 #include "MurphysLawGameMode.generated.h"
 
 
@@ -26,9 +33,54 @@ class AMurphysLawGameMode : public AGameMode
 	static const uint32 WARMUP_TIME = 30;
 	static const uint32 SCOREBOARD_TIME = 5;
 
+	/** Number of seconds between two rebuilds of the relevancy grid */
+	static const float RELEVANCY_GRID_REBUILD_INTERVAL;
+
+	/** Number of seconds between two updates of the load advertised by the session */
+	static const float ADVERTISE_LOAD_INTERVAL;
+
+	/** Weight of the last frame in the average frame time */
+	static const float FRAME_TIME_SMOOTHING;
+
 	/** Handle for efficient management of DefaultTimer timer */
 	FTimerHandle TimerHandle_DefaultTimer;
 
+	/** Handle for the periodic rebuild of the relevancy grid */
+	FTimerHandle TimerHandle_RelevancyGrid;
+
+	/** Handle for the periodic update of the load advertised by the session */
+	FTimerHandle TimerHandle_AdvertiseLoad;
+
+	/** Average duration of the frames of the server, in seconds */
+	float AverageFrameTime;
+
+	/** Number of bot moves that reached their destination during the match, to compare the crowd and non-crowd modes */
+	int32 NumberOfBotMovesCompleted;
+
+	/** Sum of the durations of the bot moves that reached their destination during the match, in seconds */
+	float TotalBotTimeToDestination;
+
+	/** Decides which characters are relevant to each connection */
+	MurphysLawRelevancyGrid RelevancyGrid;
+
+	/** Line of sight traces shared by the bots */
+	MurphysLawLineOfSightQueries LineOfSightQueries;
+
+	/** Updates the behavior trees of the bots under a per-frame budget */
+	MurphysLawAIScheduler AIScheduler;
+
+	/** Decides the targets and the shots of the bots in one pass */
+	MurphysLawBotBrain BotBrain;
+
+	/** Paths between the navigation points patrolled by the bots */
+	MurphysLawPatrolPathCache PatrolPathCache;
+
+	/** Applies the damage of the occupied damage zones */
+	MurphysLawDamageOverTime DamageOverTime;
+
+	/** Resolves the explosions over the next frames */
+	MurphysLawExplosionQueue ExplosionQueue;
+
 	/** The selected options for the game */
 	MurphysLawGameSettings GameSettings;
 
@@ -61,6 +113,22 @@ private:
 	/** update remaining time */
 	virtual void DefaultTimer();
 
+	/** Buckets the characters in the relevancy grid */
+	void RebuildRelevancyGrid();
+
+	/** Advertises the number of players and the average frame time in the session settings */
+	void AdvertiseLoad();
+
+	/** Loads the current map again with the connected players, through the transition map */
+	void TravelToNextMatch();
+
+	/** Places a new player on a team, gives it a character and notifies the other players */
+	void InitPlayerForMatch(APlayerController* NewPlayer);
+
+	/** Called when the navmesh has been rebuilt, the patrol paths are found again */
+	UFUNCTION()
+	void OnNavigationGenerationFinished(class ANavigationData* NavData);
+
 	bool ShouldSpawnAtStartSpot(AController* Player) override { return false; };
 
 	void ProcessEndGame();
@@ -68,6 +136,10 @@ private:
 	void UpdateMatchState(MurphysLawMatchState State, int32 RemainingTime);
 
 protected:
+	/** The character of the players and the bots, loaded when the match starts */
+	UPROPERTY(EditDefaultsOnly, Category = "Classes")
+	TAssetSubclassOf<APawn> CharacterClass;
+
 	/** Assign a team for a player */
 	int32 GetBestTeamForNewPlayer(APlayerState* NewPlayerState) const;
 
@@ -77,6 +149,9 @@ protected:
 public:
 	AMurphysLawGameMode();
 
+	/** Updates the bots, issues their line of sight traces, and applies the damage over time and the explosions */
+	virtual void Tick(float DeltaSeconds) override;
+
 	AActor* ChoosePlayerStart(int32 TeamNum);
 
 	/** called before startmatch */
@@ -95,6 +170,12 @@ public:
 
 	virtual void PostLogin(APlayerController* NewPlayer) override;
 
+	/** The players kept by the seamless travel don't log in again, they are placed like new players */
+	virtual void HandleSeamlessTravelPlayer(AController*& C) override;
+
+	/** Only the player states of the players travel, the bots of the next match get new ones */
+	virtual void GetSeamlessTravelActorList(bool bToTransition, TArray<AActor*>& ActorList) override;
+
 	virtual void Logout(AController* Exiting) override;
 
 	/** Get a character controlled by an AI to take its place.
@@ -108,6 +189,30 @@ public:
 	void AddCharacterForAIControl(const int32 TeamId, class APawn* ReleasedCharacter);
 
 	void SendDeathMessage(class AMurphysLawPlayerController* Killer, FString DeathMessage);
+
+	/** Decides which characters are relevant to each connection */
+	MurphysLawRelevancyGrid& GetRelevancyGrid();
+
+	/** Line of sight traces shared by the bots */
+	MurphysLawLineOfSightQueries& GetLineOfSightQueries();
+
+	/** Updates the behavior trees of the bots under a per-frame budget */
+	MurphysLawAIScheduler& GetAIScheduler();
+
+	/** Decides the targets and the shots of the bots in one pass */
+	MurphysLawBotBrain& GetBotBrain();
+
+	/** Paths between the navigation points patrolled by the bots */
+	MurphysLawPatrolPathCache& GetPatrolPathCache();
+
+	/** Applies the damage of the occupied damage zones */
+	MurphysLawDamageOverTime& GetDamageOverTime();
+
+	/** Resolves the explosions over the next frames */
+	MurphysLawExplosionQueue& GetExplosionQueue();
+
+	/** Counts a bot move that reached its destination, for the average time to destination of the match */
+	void RecordBotMoveCompleted(float TimeToDestination);
 };
 
 
@@ -2,6 +2,8 @@
 
 #include "MurphysLaw.h"
 #include "MurphysLawGameState.h"
+#include "MurphysLawPlayerController.h"
+#include "../HUD/MurphysLawHUDWidget.h"
 
 void AMurphysLawGameState::GetLifetimeReplicatedProps(TArray< FLifetimeProperty > & OutLifetimeProps) const
 {
@@ -12,6 +14,23 @@ void AMurphysLawGameState::GetLifetimeReplicatedProps(TArray< FLifetimeProperty
 	DOREPLIFETIME(AMurphysLawGameState, ScoreTeamA);
 	DOREPLIFETIME(AMurphysLawGameState, ScoreTeamB);
 	DOREPLIFETIME(AMurphysLawGameState, WinningTeam);
+	DOREPLIFETIME(AMurphysLawGameState, PickupStates);
+}
+
+// Starts the periodic update of the pickups on the server
+void AMurphysLawGameState::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (Role == ROLE_Authority)
+		GetWorldTimerManager().SetTimer(TimerHandle_PickupUpdate, this, &AMurphysLawGameState::UpdatePickups, MurphysLawPickupManager::UPDATE_INTERVAL, true);
+}
+
+// Stops the periodic update of the pickups
+void AMurphysLawGameState::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+	GetWorldTimerManager().ClearTimer(TimerHandle_PickupUpdate);
 }
 
 void AMurphysLawGameState::ResetStats()
@@ -19,6 +38,7 @@ void AMurphysLawGameState::ResetStats()
 	RemainingTime = 0.f;
 	ScoreTeamA = 0;
 	ScoreTeamB = 0;
+	MarkScoreboardDirty();
 }
 
 FString AMurphysLawGameState::GetFormattedRemainingTime()
@@ -34,14 +54,101 @@ FString AMurphysLawGameState::GetFormattedRemainingTime()
 void AMurphysLawGameState::PlayerCommitedSuicide(bool isTeamA)
 {
 	(isTeamA ? ScoreTeamA : ScoreTeamB) += SUICIDE_POINT;
+	MarkScoreboardDirty();
 }
 
 void AMurphysLawGameState::PlayerWasKilled(bool isTeamA)
 {
 	(isTeamA ? ScoreTeamA : ScoreTeamB) += KILL_POINT;
+	MarkScoreboardDirty();
 }
 
 void AMurphysLawGameState::PlayerKilledTeammate(bool isTeamA)
 {
 	(isTeamA ? ScoreTeamA : ScoreTeamB) += TEAMMATEKILL_POINT;
+	MarkScoreboardDirty();
+}
+
+// Executed when the state of the match is replicated, pushes it to the HUD of the local players
+void AMurphysLawGameState::OnRep_MurphysLawMatchState()
+{
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		AMurphysLawPlayerController* PlayerController = Cast<AMurphysLawPlayerController>(*It);
+		if (PlayerController != nullptr && PlayerController->IsLocalController() && PlayerController->GetHUDInstance() != nullptr)
+			PlayerController->GetHUDInstance()->SetMatchState(MurphysLawMatchState);
+	}
+}
+
+// Reports the score of a team, zero for the teams without score
+int32 AMurphysLawGameState::GetTeamScore(int32 Team) const
+{
+	switch (Team)
+	{
+		case 0: return ScoreTeamA;
+		case 1: return ScoreTeamB;
+		default: return 0;
+	}
+}
+
+// Called when a player joins the game
+void AMurphysLawGameState::AddPlayerState(APlayerState* PlayerState)
+{
+	Super::AddPlayerState(PlayerState);
+	MarkScoreboardDirty();
+	MarkTeamAffiliationChanged();
+}
+
+// Called when a player leaves the game
+void AMurphysLawGameState::RemovePlayerState(APlayerState* PlayerState)
+{
+	Super::RemovePlayerState(PlayerState);
+	MarkScoreboardDirty();
+	MarkTeamAffiliationChanged();
+}
+
+// Asks for the scoreboard to be rebuilt the next time it is shown
+void AMurphysLawGameState::MarkScoreboardDirty()
+{
+	Scoreboard.MarkDirty();
+}
+
+// Reports the rows of the scoreboard, rebuilt if something changed
+const MurphysLawScoreboardModel& AMurphysLawGameState::GetScoreboard()
+{
+	Scoreboard.Update(PlayerArray);
+	return Scoreboard;
+}
+
+// Asks for the teammates shown by the nameplate overlays to be recomputed
+void AMurphysLawGameState::MarkTeamAffiliationChanged()
+{
+	++TeamAffiliationVersion;
+}
+
+// Reports a number that changes each time the teammates have to be recomputed
+int32 AMurphysLawGameState::GetTeamAffiliationVersion() const { return TeamAffiliationVersion; }
+
+// Collects and respawns the pickups on the server, shows and hides them on the clients
+MurphysLawPickupManager& AMurphysLawGameState::GetPickupManager() { return PickupManager; }
+
+// Limits the exploded barrels whose chunks are simulated
+MurphysLawDebrisBudget& AMurphysLawGameState::GetDebrisBudget() { return DebrisBudget; }
+
+// Executed when the score of a team is replicated
+void AMurphysLawGameState::OnRep_TeamScore()
+{
+	MarkScoreboardDirty();
+}
+
+// Checks the collections and the respawns of the pickups
+void AMurphysLawGameState::UpdatePickups()
+{
+	PickupManager.Update(GetWorld(), PickupStates);
+}
+
+// Executed when the availability of the pickups is replicated
+void AMurphysLawGameState::OnRep_PickupStates()
+{
+	PickupManager.ApplyStates(GetWorld(), PickupStates, GetServerWorldTimeSeconds());
 }
\ No newline at end of file
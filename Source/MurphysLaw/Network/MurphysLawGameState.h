@@ -3,6 +3,9 @@
 #pragma once
 
 #include "GameFramework/GameState.h"
+#include "../HUD/MurphysLawScoreboardModel.h"
+#include "../Pickup/MurphysLawPickupManager.h"
+#include "../Environnement/ExplosiveBarrel/MurphysLawDebrisBudget.h"
 #include "MurphysLawGameState.generated.h"
 
 /**
@@ -27,29 +30,97 @@ class MURPHYSLAW_API AMurphysLawGameState : public AGameState
 	static const int32 KILL_POINT = 10;
 	static const int32 TEAMMATEKILL_POINT = -5;
 
+	/** The rows of the scoreboard, rebuilt when the players or the scores change */
+	MurphysLawScoreboardModel Scoreboard;
+
+	/** Incremented each time a player changes team or name, or a character changes player */
+	int32 TeamAffiliationVersion = 0;
+
+	/** Collects and respawns the pickups on the server, shows and hides them on the clients */
+	MurphysLawPickupManager PickupManager;
+
+	/** Limits the exploded barrels whose chunks are simulated */
+	MurphysLawDebrisBudget DebrisBudget;
+
+	/** Handle for the periodic update of the pickups */
+	FTimerHandle TimerHandle_PickupUpdate;
+
+	/** The availability of the pickups, the only pickup state sent to the clients */
+	UPROPERTY(ReplicatedUsing = OnRep_PickupStates)
+	FMurphysLawPickupStates PickupStates;
+
 public:
 	UPROPERTY(Replicated, EditDefaultsOnly, BlueprintReadOnly, Category = "GameState")
 	int32 RemainingTime;
 
-	UPROPERTY(Replicated, EditDefaultsOnly, BlueprintReadOnly, Category = "GameState")
+	UPROPERTY(ReplicatedUsing = OnRep_TeamScore, EditDefaultsOnly, BlueprintReadOnly, Category = "GameState")
 	int32 ScoreTeamA;
 
-	UPROPERTY(Replicated, EditDefaultsOnly, BlueprintReadOnly, Category = "GameState")
+	UPROPERTY(ReplicatedUsing = OnRep_TeamScore, EditDefaultsOnly, BlueprintReadOnly, Category = "GameState")
 	int32 ScoreTeamB;
 
 	UPROPERTY(Replicated, EditDefaultsOnly, BlueprintReadOnly, Category = "GameState")
 	int32 WinningTeam;
 
-	UPROPERTY(Replicated, EditDefaultsOnly, BlueprintReadWrite, Category = "GameState")
+	UPROPERTY(ReplicatedUsing = OnRep_MurphysLawMatchState, EditDefaultsOnly, BlueprintReadWrite, Category = "GameState")
 	MurphysLawMatchState MurphysLawMatchState = MurphysLawMatchState::EInLobby;
 
+	/** Executed when the state of the match is replicated, pushes it to the HUD of the local players */
+	UFUNCTION()
+	void OnRep_MurphysLawMatchState();
+
 	void GetLifetimeReplicatedProps(TArray< FLifetimeProperty > & OutLifetimeProps) const override;
 	void ResetStats();
 
+	/** Starts the periodic update of the pickups on the server */
+	void BeginPlay() override;
+
+	/** Stops the periodic update of the pickups */
+	void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	UFUNCTION(BlueprintCallable, Category = "GameState")
 	FString GetFormattedRemainingTime();
 
 	void PlayerCommitedSuicide(bool isTeamA);
 	void PlayerWasKilled(bool isTeamA);
 	void PlayerKilledTeammate(bool isTeamA);
+
+	/** Reports the score of a team, zero for the teams without score */
+	int32 GetTeamScore(int32 Team) const;
+
+	/** Called when a player joins the game */
+	void AddPlayerState(class APlayerState* PlayerState) override;
+
+	/** Called when a player leaves the game */
+	void RemovePlayerState(class APlayerState* PlayerState) override;
+
+	/** Asks for the scoreboard to be rebuilt the next time it is shown */
+	void MarkScoreboardDirty();
+
+	/** Reports the rows of the scoreboard, rebuilt if something changed */
+	const MurphysLawScoreboardModel& GetScoreboard();
+
+	/** Asks for the teammates shown by the nameplate overlays to be recomputed */
+	void MarkTeamAffiliationChanged();
+
+	/** Reports a number that changes each time the teammates have to be recomputed */
+	int32 GetTeamAffiliationVersion() const;
+
+	/** Collects and respawns the pickups on the server, shows and hides them on the clients */
+	MurphysLawPickupManager& GetPickupManager();
+
+	/** Limits the exploded barrels whose chunks are simulated */
+	MurphysLawDebrisBudget& GetDebrisBudget();
+
+private:
+	/** Executed when the score of a team is replicated */
+	UFUNCTION()
+	void OnRep_TeamScore();
+
+	/** Checks the collections and the respawns of the pickups */
+	void UpdatePickups();
+
+	/** Executed when the availability of the pickups is replicated */
+	UFUNCTION()
+	void OnRep_PickupStates();
 };
@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MurphysLaw.h"
+#include "MurphysLawNetDriver.h"
+#include "MurphysLawGameState.h"
+#include "MurphysLawPlayerState.h"
+#include "../Character/MurphysLawCharacter.h"
+
+DECLARE_CYCLE_STAT(TEXT("Net stats accounting"), STAT_ML_NetStatsAccounting, STATGROUP_MurphysLaw);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Open actor channels"), STAT_ML_OpenActorChannels, STATGROUP_MurphysLaw);
+
+static TAutoConsoleVariable<int32> CVarNetStats(
+	TEXT("MurphysLaw.NetStats"),
+	0,
+	TEXT("Accounts the bandwidth used by the game's RPCs and replicated properties, per connection.\n")
+	TEXT("The statistics are exported to Saved/Profiling/NetStats at the end of the match."));
+
+// Indicates if the bandwidth used by the game is accounted
+bool UMurphysLawNetDriver::IsAccountingEnabled()
+{
+	return CVarNetStats.GetValueOnGameThread() != 0;
+}
+
+// Indicates if the replicated properties of the actor are accounted
+bool UMurphysLawNetDriver::IsAccountedActor(const AActor* Actor)
+{
+	return Actor->IsA<AMurphysLawCharacter>()
+		|| Actor->IsA<AMurphysLawPlayerState>()
+		|| Actor->IsA<AMurphysLawGameState>();
+}
+
+// Accounts the RPC before letting the base class send it
+void UMurphysLawNetDriver::ProcessRemoteFunction(AActor* Actor, UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack, UObject* SubObject)
+{
+	// Only the functions declared by the game are accounted
+	if (IsAccountingEnabled() && Function->GetOutermost() == AMurphysLawCharacter::StaticClass()->GetOutermost())
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ML_NetStatsAccounting);
+
+		if (Function->FunctionFlags & FUNC_NetMulticast)
+		{
+			for (UNetConnection* Connection : ClientConnections)
+			{
+				if (Connection != nullptr && Connection->ActorChannels.Contains(Actor))
+					Stats.RecordRpc(Connection, Function, Parameters);
+			}
+		}
+		else if (UNetConnection* Connection = Actor->GetNetConnection())
+		{
+			Stats.RecordRpc(Connection, Function, Parameters);
+		}
+	}
+
+	Super::ProcessRemoteFunction(Actor, Function, Parameters, OutParms, Stack, SubObject);
+}
+
+// Accounts the replicated properties once the actors have been replicated
+int32 UMurphysLawNetDriver::ServerReplicateActors(float DeltaSeconds)
+{
+	const int32 Updated = Super::ServerReplicateActors(DeltaSeconds);
+
+	// Dormant actors have no channel, so this is the number of actors considered for each connection
+	for (UNetConnection* Connection : ClientConnections)
+	{
+		if (Connection != nullptr)
+			INC_DWORD_STAT_BY(STAT_ML_OpenActorChannels, Connection->ActorChannels.Num());
+	}
+
+	if (IsAccountingEnabled())
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ML_NetStatsAccounting);
+
+		// An actor's changes are sent to each connection that has a channel opened on it
+		TMap<AActor*, TArray<UNetConnection*> > Receivers;
+		for (UNetConnection* Connection : ClientConnections)
+		{
+			if (Connection == nullptr || Connection->State == USOCK_Closed) continue;
+
+			for (const auto& Pair : Connection->ActorChannels)
+			{
+				AActor* Actor = Pair.Key.Get();
+				if (Actor != nullptr && IsAccountedActor(Actor))
+					Receivers.FindOrAdd(Actor).Add(Connection);
+			}
+		}
+
+		for (const auto& Pair : Receivers)
+		{
+			Stats.RecordChangedProperties(Pair.Key, Pair.Value);
+		}
+		Stats.PurgeDestroyedActors();
+	}
+
+	return Updated;
+}
+
+// Writes the accounted statistics to a CSV file
+void UMurphysLawNetDriver::ExportStatsToCSV() const
+{
+	if (!IsAccountingEnabled()) return;
+
+	const FString Side = IsServer() ? TEXT("Server") : TEXT("Client");
+	const FString Filename = FPaths::GameSavedDir() / TEXT("Profiling") / TEXT("NetStats") / FString::Printf(TEXT("NetStats-%s-%s.csv"), *Side, *FDateTime::Now().ToString());
+
+	if (FFileHelper::SaveStringToFile(Stats.ToCSV(), *Filename))
+		ShowInfo("Network statistics exported to " + Filename);
+	else
+		ShowError("Unable to export the network statistics to " + Filename);
+}
@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "IpNetDriver.h"
+#include "MurphysLawNetStats.h"
+#include "MurphysLawNetDriver.generated.h"
+
+/**
+ * Net driver that accounts the bandwidth used by the game's RPCs and replicated properties.
+ * The accounting is enabled with the console variable MurphysLaw.NetStats and is
+ * exported to Saved/Profiling/NetStats at the end of the match.
+ */
+UCLASS(transient, config = Engine)
+class MURPHYSLAW_API UMurphysLawNetDriver : public UIpNetDriver
+{
+	GENERATED_BODY()
+
+	/** What was accounted so far */
+	MurphysLawNetStats Stats;
+
+public:
+	/** Accounts the RPC before letting the base class send it */
+	virtual void ProcessRemoteFunction(class AActor* Actor, class UFunction* Function, void* Parameters, struct FOutParmRec* OutParms, struct FFrame* Stack, class UObject* SubObject = NULL) override;
+
+	/** Accounts the replicated properties once the actors have been replicated */
+	virtual int32 ServerReplicateActors(float DeltaSeconds) override;
+
+	/** Writes the accounted statistics to a CSV file */
+	void ExportStatsToCSV() const;
+
+	/** Indicates if the bandwidth used by the game is accounted */
+	static bool IsAccountingEnabled();
+
+private:
+	/** Indicates if the replicated properties of the actor are accounted */
+	static bool IsAccountedActor(const AActor* Actor);
+};
@@ -0,0 +1,252 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MurphysLaw.h"
+#include "MurphysLawNetStats.h"
+
+const int32 MurphysLawNetStats::OBJECT_REFERENCE_BITS(32);
+const int32 MurphysLawNetStats::LENGTH_PREFIX_BITS(32);
+const int32 MurphysLawNetStats::MAX_NET_SERIALIZE_BITS(4096);
+
+MurphysLawNetStats::MurphysLawNetStats() {}
+
+MurphysLawNetStats::~MurphysLawNetStats() {}
+
+#pragma region Property shadows
+
+MurphysLawNetStats::PropertyShadow::PropertyShadow(const UProperty* InProperty, const void* Source)
+	: Property(InProperty), Value(static_cast<uint8*>(FMemory::Malloc(InProperty->GetSize(), InProperty->GetMinAlignment())))
+{
+	Property->InitializeValue(Value);
+	Property->CopyCompleteValue(Value, Source);
+}
+
+MurphysLawNetStats::PropertyShadow::~PropertyShadow()
+{
+	Property->DestroyValue(Value);
+	FMemory::Free(Value);
+}
+
+// Updates the copy and reports if the value has changed
+bool MurphysLawNetStats::PropertyShadow::Update(const void* Source)
+{
+	const uint8* SourceValue = static_cast<const uint8*>(Source);
+	for (int32 i = 0; i < Property->ArrayDim; ++i)
+	{
+		const int32 Offset = i * Property->ElementSize;
+		if (!Property->Identical(SourceValue + Offset, Value + Offset))
+		{
+			Property->CopyCompleteValue(Value, Source);
+			return true;
+		}
+	}
+	return false;
+}
+
+#pragma endregion
+
+// Accounts an RPC sent through the connection
+void MurphysLawNetStats::RecordRpc(UNetConnection* Connection, const UFunction* Function, const void* Parameters)
+{
+	int64 Bits = 0;
+	for (TFieldIterator<UProperty> It(Function); It && (It->PropertyFlags & (CPF_Parm | CPF_ReturnParm)) == CPF_Parm; ++It)
+	{
+		Bits += EstimatePropertyBits(*It, It->ContainerPtrToValuePtr<void>(Parameters));
+	}
+
+	Entry& RpcEntry = GetRecord(Connection).Rpcs.FindOrAdd(Function);
+	++RpcEntry.Count;
+	RpcEntry.Bits += Bits;
+}
+
+// Accounts the replicated properties of the actor that changed since the last call
+void MurphysLawNetStats::RecordChangedProperties(const AActor* Actor, const TArray<UNetConnection*>& Receivers)
+{
+	const TArray<const UProperty*>& ReplicatedProperties = GetReplicatedProperties(Actor->GetClass());
+
+	TSharedPtr<ActorShadow>& Shadow = ActorShadows.FindOrAdd(Actor);
+	if (!Shadow.IsValid())
+	{
+		// First time the actor is seen, everything gets sent with the initial bunch
+		Shadow = MakeShareable(new ActorShadow);
+		Shadow->Properties.Reserve(ReplicatedProperties.Num());
+		for (const UProperty* Property : ReplicatedProperties)
+		{
+			const void* ValuePtr = Property->ContainerPtrToValuePtr<void>(Actor);
+			Shadow->Properties.Emplace(Property, ValuePtr);
+			RecordProperty(Property, ValuePtr, Actor, Receivers);
+		}
+		return;
+	}
+
+	for (PropertyShadow& PropertyCopy : Shadow->Properties)
+	{
+		const void* ValuePtr = PropertyCopy.Property->ContainerPtrToValuePtr<void>(Actor);
+		if (PropertyCopy.Update(ValuePtr) && ReplicationConditions.FindRef(PropertyCopy.Property) != COND_InitialOnly)
+		{
+			RecordProperty(PropertyCopy.Property, ValuePtr, Actor, Receivers);
+		}
+	}
+}
+
+// Accounts the value of a property for the connections its replication condition sends it to
+void MurphysLawNetStats::RecordProperty(const UProperty* Property, const void* ValuePtr, const AActor* Actor, const TArray<UNetConnection*>& Receivers)
+{
+	const ELifetimeCondition Condition = ReplicationConditions.FindRef(Property);
+	const UNetConnection* OwnerConnection = Actor->GetNetConnection();
+
+	const int64 Bits = EstimatePropertyBits(Property, ValuePtr);
+	for (UNetConnection* Connection : Receivers)
+	{
+		const bool IsOwner = Connection == OwnerConnection;
+		if ((Condition == COND_OwnerOnly && !IsOwner) || (Condition == COND_SkipOwner && IsOwner)) continue;
+
+		Entry& PropertyEntry = GetRecord(Connection).Properties.FindOrAdd(Property);
+		++PropertyEntry.Count;
+		PropertyEntry.Bits += Bits;
+	}
+}
+
+// Forgets the accounted values of the actors that were destroyed
+void MurphysLawNetStats::PurgeDestroyedActors()
+{
+	for (auto It = ActorShadows.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid()) It.RemoveCurrent();
+	}
+}
+
+// Writes everything accounted so far as CSV
+FString MurphysLawNetStats::ToCSV() const
+{
+	FString Result = TEXT("Connection,Kind,Class,Name,Count,Bytes\r\n");
+	for (const ConnectionRecord& Record : Records)
+	{
+		for (const auto& Pair : Record.Rpcs)
+		{
+			Result += FString::Printf(TEXT("%s,RPC,%s,%s,%d,%lld\r\n"), *Record.Description,
+				*Pair.Key->GetOwnerClass()->GetName(), *Pair.Key->GetName(), Pair.Value.Count, (Pair.Value.Bits + 7) / 8);
+		}
+		for (const auto& Pair : Record.Properties)
+		{
+			Result += FString::Printf(TEXT("%s,Property,%s,%s,%d,%lld\r\n"), *Record.Description,
+				*Pair.Key->GetOwnerClass()->GetName(), *Pair.Key->GetName(), Pair.Value.Count, (Pair.Value.Bits + 7) / 8);
+		}
+	}
+	return Result;
+}
+
+// Estimates the number of bits needed to send the value of a property
+int64 MurphysLawNetStats::EstimatePropertyBits(const UProperty* Property, const void* ValuePtr)
+{
+	int64 Bits = 0;
+	for (int32 i = 0; i < Property->ArrayDim; ++i)
+	{
+		const uint8* ElementPtr = static_cast<const uint8*>(ValuePtr) + i * Property->ElementSize;
+
+		if (Property->IsA<UBoolProperty>())
+		{
+			Bits += 1;
+		}
+		else if (Property->IsA<UObjectPropertyBase>())
+		{
+			Bits += OBJECT_REFERENCE_BITS;
+		}
+		else if (const UStrProperty* StrProperty = Cast<const UStrProperty>(Property))
+		{
+			Bits += LENGTH_PREFIX_BITS + (StrProperty->GetPropertyValue(ElementPtr).Len() + 1) * 8;
+		}
+		else if (const UNameProperty* NameProperty = Cast<const UNameProperty>(Property))
+		{
+			Bits += LENGTH_PREFIX_BITS + (NameProperty->GetPropertyValue(ElementPtr).ToString().Len() + 1) * 8;
+		}
+		else if (const UStructProperty* StructProperty = Cast<const UStructProperty>(Property))
+		{
+			// Structs that serialize themselves are measured by actually serializing them
+			UScriptStruct::ICppStructOps* StructOps = StructProperty->Struct->GetCppStructOps();
+			if ((StructProperty->Struct->StructFlags & STRUCT_NetSerializeNative) && StructOps != nullptr)
+			{
+				FNetBitWriter Writer(nullptr, MAX_NET_SERIALIZE_BITS);
+				bool Success = true;
+				StructOps->NetSerialize(Writer, nullptr, Success, const_cast<uint8*>(ElementPtr));
+				Bits += Writer.GetNumBits();
+				continue;
+			}
+
+			for (TFieldIterator<UProperty> It(StructProperty->Struct); It; ++It)
+			{
+				Bits += EstimatePropertyBits(*It, It->ContainerPtrToValuePtr<void>(ElementPtr));
+			}
+		}
+		else if (const UArrayProperty* ArrayProperty = Cast<const UArrayProperty>(Property))
+		{
+			FScriptArrayHelper Helper(ArrayProperty, ElementPtr);
+			Bits += LENGTH_PREFIX_BITS;
+			for (int32 j = 0; j < Helper.Num(); ++j)
+			{
+				Bits += EstimatePropertyBits(ArrayProperty->Inner, Helper.GetRawPtr(j));
+			}
+		}
+		else
+		{
+			Bits += Property->ElementSize * 8;
+		}
+	}
+	return Bits;
+}
+
+// Reports the record of the connection, creating it if needed
+MurphysLawNetStats::ConnectionRecord& MurphysLawNetStats::GetRecord(UNetConnection* Connection)
+{
+	if (int32* Index = RecordIndices.Find(Connection))
+	{
+		return Records[*Index];
+	}
+
+	const int32 NewIndex = Records.AddDefaulted();
+	Records[NewIndex].Description = DescribeConnection(Connection);
+	RecordIndices.Add(Connection, NewIndex);
+	return Records[NewIndex];
+}
+
+// Reports the replicated properties declared by a class and its parents
+const TArray<const UProperty*>& MurphysLawNetStats::GetReplicatedProperties(const UClass* Class)
+{
+	TArray<const UProperty*>* Properties = ReplicatedPropertiesPerClass.Find(Class);
+	if (Properties == nullptr)
+	{
+		Properties = &ReplicatedPropertiesPerClass.Add(Class);
+		for (TFieldIterator<UProperty> It(Class); It; ++It)
+		{
+			if (It->PropertyFlags & CPF_Net) Properties->Add(*It);
+		}
+
+		// The conditions are only known by the class default object
+		TArray<FLifetimeProperty> LifetimeProperties;
+		Class->GetDefaultObject<AActor>()->GetLifetimeReplicatedProps(LifetimeProperties);
+		for (const UProperty* Property : *Properties)
+		{
+			for (const FLifetimeProperty& LifetimeProperty : LifetimeProperties)
+			{
+				if (LifetimeProperty.RepIndex == Property->RepIndex)
+				{
+					ReplicationConditions.Add(Property, LifetimeProperty.Condition);
+					break;
+				}
+			}
+		}
+	}
+	return *Properties;
+}
+
+// Builds a readable name for the connection
+FString MurphysLawNetStats::DescribeConnection(UNetConnection* Connection)
+{
+	FString Description = Connection->LowLevelGetRemoteAddress(true);
+	if (Connection->PlayerController != nullptr && Connection->PlayerController->PlayerState != nullptr)
+	{
+		Description = Connection->PlayerController->PlayerState->PlayerName + TEXT(" (") + Description + TEXT(")");
+	}
+
+	// Commas would break the CSV columns
+	return Description.Replace(TEXT(","), TEXT(" "));
+}
@@ -0,0 +1,95 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+/**
+ * Accounts the bandwidth used by the RPCs and the replicated properties of the game,
+ * broken down per connection.
+ *
+ * Sizes are estimated from the values themselves (no packet headers, no delta compression)
+ * which is enough to compare the RPCs and properties against each other.
+ */
+class MURPHYSLAW_API MurphysLawNetStats
+{
+	/** Number of bits estimated for an object reference (a NetGUID) */
+	static const int32 OBJECT_REFERENCE_BITS;
+
+	/** Number of bits estimated for the length of strings and dynamic arrays */
+	static const int32 LENGTH_PREFIX_BITS;
+
+	/** Maximum number of bits written when measuring a struct with a custom NetSerialize */
+	static const int32 MAX_NET_SERIALIZE_BITS;
+
+	/** Accumulated cost of an RPC or a property */
+	struct Entry
+	{
+		int32 Count;
+		int64 Bits;
+	};
+
+	/** Everything accounted for a single connection */
+	struct ConnectionRecord
+	{
+		FString Description;
+		TMap<const UFunction*, Entry> Rpcs;
+		TMap<const UProperty*, Entry> Properties;
+	};
+
+	/** Copy of the last value accounted for a replicated property */
+	struct PropertyShadow
+	{
+		const UProperty* Property;
+		uint8* Value;
+
+		PropertyShadow(const UProperty* InProperty, const void* Source);
+		~PropertyShadow();
+
+		/** Updates the copy and reports if the value has changed */
+		bool Update(const void* Source);
+	};
+
+	/** Last accounted values of the replicated properties of an actor */
+	struct ActorShadow
+	{
+		TArray<PropertyShadow> Properties;
+	};
+
+	TArray<ConnectionRecord> Records;
+	TMap<TWeakObjectPtr<UNetConnection>, int32> RecordIndices;
+	TMap<TWeakObjectPtr<const AActor>, TSharedPtr<ActorShadow> > ActorShadows;
+	TMap<const UClass*, TArray<const UProperty*> > ReplicatedPropertiesPerClass;
+	TMap<const UProperty*, ELifetimeCondition> ReplicationConditions;
+
+public:
+	MurphysLawNetStats();
+	~MurphysLawNetStats();
+
+	/** Accounts an RPC sent through the connection */
+	void RecordRpc(UNetConnection* Connection, const UFunction* Function, const void* Parameters);
+
+	/** Accounts the replicated properties of the actor that changed since the last call
+		for each connection that has a channel opened on it */
+	void RecordChangedProperties(const AActor* Actor, const TArray<UNetConnection*>& Receivers);
+
+	/** Forgets the accounted values of the actors that were destroyed */
+	void PurgeDestroyedActors();
+
+	/** Writes everything accounted so far as CSV */
+	FString ToCSV() const;
+
+	/** Estimates the number of bits needed to send the value of a property */
+	static int64 EstimatePropertyBits(const UProperty* Property, const void* ValuePtr);
+
+private:
+	/** Reports the record of the connection, creating it if needed */
+	ConnectionRecord& GetRecord(UNetConnection* Connection);
+
+	/** Reports the replicated properties declared by a class and its parents */
+	const TArray<const UProperty*>& GetReplicatedProperties(const UClass* Class);
+
+	/** Accounts the value of a property for the connections its replication condition sends it to */
+	void RecordProperty(const UProperty* Property, const void* ValuePtr, const AActor* Actor, const TArray<UNetConnection*>& Receivers);
+
+	/** Builds a readable name for the connection */
+	static FString DescribeConnection(UNetConnection* Connection);
+};
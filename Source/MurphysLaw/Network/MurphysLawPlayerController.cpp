@@ -8,14 +8,21 @@
 #include "MurphysLawGameInstance.h"
 #include "MurphysLawGameMode.h"
 #include "MurphysLawPlayerStart.h"
+#include "MurphysLawNetDriver.h"
 #include "../HUD/MurphysLawHUDWidget.h"
 #include "../Menu/MurphysLawInGameMenu.h"
 #include "../HUD/MurphysLawScoreboardWidget.h"
+#include "../HUD/MurphysLawNameplateOverlay.h"
+#include "../Pickup/MurphysLawPickupManager.h"
 #include "../Utils/MurphysLawUtils.h"
+#include "../Utils/MurphysLawAssetStreamer.h"
 
 AMurphysLawPlayerController::AMurphysLawPlayerController()
 {
 	InitSoundEffects();
+
+	// The nameplates are drawn natively, a blueprint subclass is only needed to change their look
+	NameplateOverlayClass = UMurphysLawNameplateOverlay::StaticClass();
 }
 
 void AMurphysLawPlayerController::PostLoginDone_Implementation()
@@ -56,6 +63,17 @@ void AMurphysLawPlayerController::ChangeHUDVisibility(ESlateVisibility visibilit
 {
 	if (HUDInstance)
 		HUDInstance->SetVisibility(visibility);
+
+	// The nameplates are shown along with the HUD, but never block the mouse
+	if (NameplateOverlayInstance)
+		NameplateOverlayInstance->SetVisibility(visibility == ESlateVisibility::Visible ? ESlateVisibility::HitTestInvisible : visibility);
+}
+
+// Reports the team of the player, as the engine's team identifier
+FGenericTeamId AMurphysLawPlayerController::GetGenericTeamId() const
+{
+	const AMurphysLawPlayerState* MurphysLawPlayerState = Cast<AMurphysLawPlayerState>(PlayerState);
+	return MurphysLawPlayerState != nullptr ? MurphysLawPlayerState->GetGenericTeamId() : FGenericTeamId::NoTeam;
 }
 
 void AMurphysLawPlayerController::RefreshPlayerList_Implementation()
@@ -68,9 +86,10 @@ void AMurphysLawPlayerController::RefreshPlayerList_Implementation()
 void AMurphysLawPlayerController::OnKilled(const float TimeToRespawn)
 {
 	int32 index = FMath::RandRange(0, DeathSounds.Num() - 1);
-	if (DeathSounds.IsValidIndex(index) && DeathSounds[index] != nullptr) 
+	USoundBase* DeathSound = DeathSounds.IsValidIndex(index) ? DeathSounds[index].Get() : nullptr;
+	if (DeathSound != nullptr) 
 	{
-		UGameplayStatics::PlaySoundAtLocation(this, DeathSounds[index], GetPawn()->GetActorLocation());
+		UGameplayStatics::PlaySoundAtLocation(this, DeathSound, GetPawn()->GetActorLocation());
 	}
 	DisableInput(this);
 	UnPossess();
@@ -80,9 +99,10 @@ void AMurphysLawPlayerController::OnKilled(const float TimeToRespawn)
 void AMurphysLawPlayerController::OnKilledOther_Implementation()
 {
 	int32 index = FMath::RandRange(0, KillSounds.Num() - 1);
-	if (KillSounds.IsValidIndex(index) && KillSounds[index] != nullptr)
+	USoundBase* KillSound = KillSounds.IsValidIndex(index) ? KillSounds[index].Get() : nullptr;
+	if (KillSound != nullptr)
 	{
-		UGameplayStatics::PlaySoundAtLocation(this, KillSounds[index], GetPawn()->GetActorLocation());
+		UGameplayStatics::PlaySoundAtLocation(this, KillSound, GetPawn()->GetActorLocation());
 	}
 }
 
@@ -107,6 +127,14 @@ void AMurphysLawPlayerController::OnMatchHasEnded_Implementation()
 		ToggleInGameMenu();
 	DisableInput(this);
 	ShowScoreboard();
+
+	// The server exports its own statistics, clients export what they sent to it
+	if (GetNetMode() == NM_Client)
+	{
+		UMurphysLawNetDriver* NetDriver = Cast<UMurphysLawNetDriver>(GetNetDriver());
+		if (NetDriver)
+			NetDriver->ExportStatsToCSV();
+	}
 }
 
 void AMurphysLawPlayerController::OnSendDeathMessage_Implementation(const FString& DeathMessage)
@@ -143,29 +171,48 @@ void AMurphysLawPlayerController::BeginPlayingState()
 		IsInGameMenuOpen = false;
 
 		SpawnWidgets();
+		LoadSoundEffects();
+
+		UMurphysLawGameInstance* GameInstance = Cast<UMurphysLawGameInstance>(GetGameInstance());
+		if (GameInstance)
+			GameInstance->EndMatchTravel();
 	}
 }
 
+// Starts measuring the time until the player can play when the server keeps it connected to the next match
+void AMurphysLawPlayerController::PreClientTravel(const FString& PendingURL, ETravelType TravelType, bool bIsSeamlessTravel)
+{
+	Super::PreClientTravel(PendingURL, TravelType, bIsSeamlessTravel);
+
+	UMurphysLawGameInstance* GameInstance = Cast<UMurphysLawGameInstance>(GetGameInstance());
+	if (GameInstance && bIsSeamlessTravel)
+		GameInstance->BeginMatchTravel(true);
+}
+
 void AMurphysLawPlayerController::InitSoundEffects()
 {
-	// Try to load the sound of switching weapon
-	static ConstructorHelpers::FObjectFinder<USoundBase> DeathSound1(TEXT("SoundWave'/Game/MurphysLawRessources/SoundEffects/S_BeAManAndConfrontSomebody.S_BeAManAndConfrontSomebody'"));
-	static ConstructorHelpers::FObjectFinder<USoundBase> DeathSound2(TEXT("SoundWave'/Game/MurphysLawRessources/SoundEffects/S_ImSickOfThis.S_ImSickOfThis'"));
-	static ConstructorHelpers::FObjectFinder<USoundBase> DeathSound3(TEXT("SoundWave'/Game/MurphysLawRessources/SoundEffects/S_OldLameAssNigga.S_OldLameAssNigga'"));
-	static ConstructorHelpers::FObjectFinder<USoundBase> DeathSound4(TEXT("SoundWave'/Game/MurphysLawRessources/SoundEffects/S_OhMyGodNoNo.S_OhMyGodNoNo'"));
-	
-	static ConstructorHelpers::FObjectFinder<USoundBase> KillSound1(TEXT("SoundWave'/Game/MurphysLawRessources/SoundEffects/S_LocalAssBitch.S_LocalAssBitch'"));
-	static ConstructorHelpers::FObjectFinder<USoundBase> KillSound2(TEXT("SoundWave'/Game/MurphysLawRessources/SoundEffects/S_YeahBitchImAKiller.S_YeahBitchImAKiller'"));
-	static ConstructorHelpers::FObjectFinder<USoundBase> KillSound3(TEXT("SoundWave'/Game/MurphysLawRessources/SoundEffects/S_YouAintGotNoDaddy.S_YouAintGotNoDaddy'"));
-
-	if (DeathSound1.Succeeded()) DeathSounds.Add(DeathSound1.Object);
-	if (DeathSound2.Succeeded()) DeathSounds.Add(DeathSound2.Object);
-	if (DeathSound3.Succeeded()) DeathSounds.Add(DeathSound3.Object);
-	if (DeathSound4.Succeeded()) DeathSounds.Add(DeathSound4.Object);
-
-	if (KillSound1.Succeeded()) KillSounds.Add(KillSound1.Object);
-	if (KillSound2.Succeeded()) KillSounds.Add(KillSound2.Object);
-	if (KillSound3.Succeeded()) KillSounds.Add(KillSound3.Object);
+	// Only the paths are known here, the sounds are loaded when the local player starts playing
+	DeathSounds.Emplace(FStringAssetReference(TEXT("/Game/MurphysLawRessources/SoundEffects/S_BeAManAndConfrontSomebody.S_BeAManAndConfrontSomebody")));
+	DeathSounds.Emplace(FStringAssetReference(TEXT("/Game/MurphysLawRessources/SoundEffects/S_ImSickOfThis.S_ImSickOfThis")));
+	DeathSounds.Emplace(FStringAssetReference(TEXT("/Game/MurphysLawRessources/SoundEffects/S_OldLameAssNigga.S_OldLameAssNigga")));
+	DeathSounds.Emplace(FStringAssetReference(TEXT("/Game/MurphysLawRessources/SoundEffects/S_OhMyGodNoNo.S_OhMyGodNoNo")));
+
+	KillSounds.Emplace(FStringAssetReference(TEXT("/Game/MurphysLawRessources/SoundEffects/S_LocalAssBitch.S_LocalAssBitch")));
+	KillSounds.Emplace(FStringAssetReference(TEXT("/Game/MurphysLawRessources/SoundEffects/S_YeahBitchImAKiller.S_YeahBitchImAKiller")));
+	KillSounds.Emplace(FStringAssetReference(TEXT("/Game/MurphysLawRessources/SoundEffects/S_YouAintGotNoDaddy.S_YouAintGotNoDaddy")));
+}
+
+// Loads the sound effects in the background, only the local player hears them
+void AMurphysLawPlayerController::LoadSoundEffects()
+{
+	MurphysLawAssetStreamer* AssetStreamer = MurphysLawAssetStreamer::Get(GetWorld());
+	if (AssetStreamer == nullptr) return;
+
+	TArray<FStringAssetReference> Sounds;
+	for (const TAssetPtr<USoundBase>& Sound : DeathSounds) Sounds.Add(Sound.ToStringReference());
+	for (const TAssetPtr<USoundBase>& Sound : KillSounds) Sounds.Add(Sound.ToStringReference());
+
+	AssetStreamer->RequestAsyncLoad(StaticClass(), Sounds);
 }
 
 void AMurphysLawPlayerController::SetupInputComponent()
@@ -262,6 +309,17 @@ void AMurphysLawPlayerController::ToggleInGameMenu()
 // Called to spawn all the UserWidgets of the player
 void AMurphysLawPlayerController::SpawnWidgets()
 {
+	// The nameplates are created first to be drawn below the other widgets
+	if (NameplateOverlayClass && !NameplateOverlayInstance)
+	{
+		NameplateOverlayInstance = CreateWidget<UMurphysLawNameplateOverlay>(GetWorld(), NameplateOverlayClass);
+		if (NameplateOverlayInstance)
+		{
+			NameplateOverlayInstance->AddToViewport();
+			NameplateOverlayInstance->SetPlayerController(this);
+		}
+	}
+
 	// Check if the HUD type has been set
 	if (HUDWidgetClass && !HUDInstance)
 	{
@@ -385,6 +443,14 @@ void AMurphysLawPlayerController::Client_ShowDamage_Implementation(float Angle)
 	}
 }
 
+// Applies on the client a pickup the server says the pawn collected
+void AMurphysLawPlayerController::Client_CollectPickup_Implementation(int32 PickupIndex)
+{
+	MurphysLawPickupManager* PickupManager = MurphysLawPickupManager::Get(GetWorld());
+	if (PickupManager != nullptr)
+		PickupManager->CollectOnClient(GetWorld(), PickupIndex, Cast<AMurphysLawCharacter>(GetPawn()));
+}
+
 void AMurphysLawPlayerController::PickedUpItem(class USoundBase* CollectSound)
 {
 	/*if (IsLocalPlayerController() && CollectSound)
@@ -12,13 +12,13 @@
  * 
  */
 UCLASS()
-class MURPHYSLAW_API AMurphysLawPlayerController : public APlayerController, public IMurphysLawIController
+class MURPHYSLAW_API AMurphysLawPlayerController : public APlayerController, public IMurphysLawIController, public IGenericTeamAgentInterface
 {
 	GENERATED_BODY()
 
-	/** Sound to play each time we die */
-	TArray<class USoundBase*> DeathSounds;
-	TArray<class USoundBase*> KillSounds;
+	/** Sound to play each time we die, loaded when the local player starts playing */
+	TArray<TAssetPtr<class USoundBase>> DeathSounds;
+	TArray<TAssetPtr<class USoundBase>> KillSounds;
 
 public:	
 	AMurphysLawPlayerController();
@@ -66,6 +66,9 @@ public:
 	/** Reports the instance of the character */
 	FORCEINLINE class AMurphysLawCharacter* GetMyCharacter() const { return MyCharacter; }
 
+	/** Reports the team of the player, as the engine's team identifier */
+	FGenericTeamId GetGenericTeamId() const override;
+
 	/** Reports the instance of the HUD */
 	FORCEINLINE class UMurphysLawHUDWidget* GetHUDInstance() const { return HUDInstance; }
 
@@ -74,10 +77,17 @@ public:
 
 	void PickedUpItem(class USoundBase* CollectSound);
 
+	/** Applies on the client a pickup the server says the pawn collected */
+	UFUNCTION(Reliable, Client)
+	void Client_CollectPickup(int32 PickupIndex);
+
 	/** Empty function so that the base class doesn't destroy the pawn (the pawn is re-used by a AIController */
 	void PawnLeavingGame() override;
 
 	void ChangeHUDVisibility(ESlateVisibility visibility);
+
+	/** Starts measuring the time until the player can play when the server keeps it connected to the next match */
+	void PreClientTravel(const FString& PendingURL, ETravelType TravelType, bool bIsSeamlessTravel) override;
 	
 protected:
 	/** Called when the pawn has been possessed */
@@ -96,6 +106,14 @@ protected:
 	UPROPERTY(BlueprintReadWrite, Category = "HUD")
 	class UMurphysLawHUDWidget* HUDInstance;
 
+	/** The type of the layer drawing the names of the teammates */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "HUD", Meta = (BlueprintProtected = "true"))
+	TSubclassOf<class UMurphysLawNameplateOverlay> NameplateOverlayClass;
+
+	/** The instance of the layer drawing the names of the teammates */
+	UPROPERTY()
+	class UMurphysLawNameplateOverlay* NameplateOverlayInstance;
+
 	/** The type of the In-Game menu */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "InGameMenu", Meta = (BlueprintProtected = "true"))
 	TSubclassOf<class UMurphysLawInGameMenu> InGameMenuClass;
@@ -137,6 +155,9 @@ private:
 
 	void InitSoundEffects();
 
+	/** Loads the sound effects in the background, only the local player hears them */
+	void LoadSoundEffects();
+
 #pragma region Input Callback functions
 
 	/** Callbacks of the EquipWeapon keys */
@@ -2,6 +2,8 @@
 
 #include "MurphysLaw.h"
 #include "MurphysLawPlayerState.h"
+#include "MurphysLawGameState.h"
+#include "../Character/MurphysLawCharacter.h"
 #include "UnrealNetwork.h"
 
 // Indicates to the server what properties of the object to replicate on the clients
@@ -27,6 +29,32 @@ int32 AMurphysLawPlayerState::GetTeam() const
 void AMurphysLawPlayerState::SetTeam(int32 NewTeam)
 {
 	Team = NewTeam;
+	NotifyScoreboardChanged();
+	NotifyTeamAffiliationChanged();
+
+	// The perception of the bots only detects the other teams
+	IGenericTeamAgentInterface* TeamAgent = Cast<IGenericTeamAgentInterface>(GetOwner());
+	if (TeamAgent != nullptr)
+		TeamAgent->SetGenericTeamId(GetGenericTeamId());
+
+	// The sight of the bots also keeps the team of the character the player controls
+	AController* OwnerController = Cast<AController>(GetOwner());
+	AMurphysLawCharacter* Character = OwnerController != nullptr ? Cast<AMurphysLawCharacter>(OwnerController->GetPawn()) : nullptr;
+	if (Character != nullptr)
+		Character->UpdatePerceptionTeam();
+}
+
+// Reports the team as the engine's team identifier, used by the AI perception
+FGenericTeamId AMurphysLawPlayerState::GetGenericTeamId() const
+{
+	return Team >= 0 && Team < FGenericTeamId::NoTeam.GetId() ? FGenericTeamId(static_cast<uint8>(Team)) : FGenericTeamId::NoTeam;
+}
+
+// Called on the client when Team property is changed by the server
+void AMurphysLawPlayerState::OnRep_Team()
+{
+	NotifyScoreboardChanged();
+	NotifyTeamAffiliationChanged();
 }
 
 #pragma endregion
@@ -59,12 +87,13 @@ bool AMurphysLawPlayerState::Server_IncrementNbKills_Validate() { return true; }
 void AMurphysLawPlayerState::Server_IncrementNbKills_Implementation()
 {
 	NbKills++;
+	NotifyScoreboardChanged();
 }
 
 // Called on the client when NbKills property is changed by the server
 void AMurphysLawPlayerState::OnRep_IncrementNbKills()
 {
-	// do nothing, because the number of kills doesn't affect anything in the UI yet
+	NotifyScoreboardChanged();
 }
 
 #pragma endregion
@@ -97,12 +126,13 @@ bool AMurphysLawPlayerState::Server_IncrementNbDeaths_Validate() { return true;
 void AMurphysLawPlayerState::Server_IncrementNbDeaths_Implementation()
 {
 	NbDeaths++;
+	NotifyScoreboardChanged();
 }
 
 // Called on the client when NbDeaths property is changed by the server
 void AMurphysLawPlayerState::OnRep_IncrementNbDeaths()
 {
-	// do nothing, because the number of deaths doesn't affect anything in the UI yet
+	NotifyScoreboardChanged();
 }
 
 #pragma endregion
@@ -115,10 +145,51 @@ bool AMurphysLawPlayerState::IsActive() const
 void AMurphysLawPlayerState::SetActive(bool Active)
 {
 	this->Active = Active;
+	NotifyScoreboardChanged();
+}
+
+// Called on the client when Active property is changed by the server
+void AMurphysLawPlayerState::OnRep_Active()
+{
+	NotifyScoreboardChanged();
 }
 
 void AMurphysLawPlayerState::ResetStats()
 {
 	NbKills = 0;
 	NbDeaths = 0;
+	NotifyScoreboardChanged();
+}
+
+// Sets the name of the player
+void AMurphysLawPlayerState::SetPlayerName(const FString& S)
+{
+	Super::SetPlayerName(S);
+	NotifyScoreboardChanged();
+	NotifyTeamAffiliationChanged();
+}
+
+// Called on the client when the name of the player is changed by the server
+void AMurphysLawPlayerState::OnRep_PlayerName()
+{
+	Super::OnRep_PlayerName();
+	NotifyScoreboardChanged();
+	NotifyTeamAffiliationChanged();
+}
+
+// Lets the scoreboard know that it has to be rebuilt
+void AMurphysLawPlayerState::NotifyScoreboardChanged() const
+{
+	// The player state can be replicated before the game state, which rebuilds its scoreboard once it gets the player
+	AMurphysLawGameState* GameState = GetWorld() != nullptr ? GetWorld()->GetGameState<AMurphysLawGameState>() : nullptr;
+	if (GameState != nullptr)
+		GameState->MarkScoreboardDirty();
+}
+
+// Lets the nameplate overlays know that the teammates have to be recomputed
+void AMurphysLawPlayerState::NotifyTeamAffiliationChanged() const
+{
+	AMurphysLawGameState* GameState = GetWorld() != nullptr ? GetWorld()->GetGameState<AMurphysLawGameState>() : nullptr;
+	if (GameState != nullptr)
+		GameState->MarkTeamAffiliationChanged();
 }
\ No newline at end of file
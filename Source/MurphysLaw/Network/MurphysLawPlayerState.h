@@ -3,6 +3,7 @@
 #pragma once
 
 #include "GameFramework/PlayerState.h"
+#include "GenericTeamAgentInterface.h"
 #include "MurphysLawPlayerState.generated.h"
 
 /**
@@ -20,6 +21,23 @@ public:
 	bool IsActive() const;
 	void SetActive(bool Active);
 
+	/** Sets the name of the player */
+	void SetPlayerName(const FString& S) override;
+
+	/** Called on the client when the name of the player is changed by the server */
+	void OnRep_PlayerName() override;
+
+private:
+	/** Lets the scoreboard know that it has to be rebuilt */
+	void NotifyScoreboardChanged() const;
+
+	/** Lets the nameplate overlays know that the teammates have to be recomputed */
+	void NotifyTeamAffiliationChanged() const;
+
+	/** Called on the client when Active property is changed by the server */
+	UFUNCTION()
+	void OnRep_Active();
+
 #pragma region Team properties and methods
 	
 public:
@@ -29,11 +47,18 @@ public:
 	/** Sets the new team of the player */
 	void SetTeam(int32 NewTeam);
 
+	/** Reports the team as the engine's team identifier, used by the AI perception */
+	FGenericTeamId GetGenericTeamId() const;
+
+	/** Called on the client when Team property is changed by the server */
+	UFUNCTION()
+	void OnRep_Team();
+
 protected:
-	UPROPERTY(Replicated, BlueprintReadWrite, Category = "PlayerState")
+	UPROPERTY(ReplicatedUsing = OnRep_Team, BlueprintReadWrite, Category = "PlayerState")
 	int32 Team;
 
-	UPROPERTY(Replicated, BlueprintReadWrite, Category = "PlayerState")
+	UPROPERTY(ReplicatedUsing = OnRep_Active, BlueprintReadWrite, Category = "PlayerState")
 	bool Active = false;
 
 #pragma endregion
@@ -0,0 +1,162 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MurphysLaw.h"
+#include "MurphysLawRelevancyGrid.h"
+#include "MurphysLawGameMode.h"
+#include "MurphysLawPlayerState.h"
+#include "../Character/MurphysLawCharacter.h"
+
+DECLARE_CYCLE_STAT(TEXT("Relevancy grid rebuild"), STAT_ML_RelevancyGridRebuild, STATGROUP_MurphysLaw);
+DECLARE_CYCLE_STAT(TEXT("Relevancy viewer refresh"), STAT_ML_RelevancyViewerRefresh, STATGROUP_MurphysLaw);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Relevancy viewer refreshes"), STAT_ML_RelevancyViewerRefreshes, STATGROUP_MurphysLaw);
+
+const float MurphysLawRelevancyGrid::CELL_SIZE(2500.f);				// 25 meters
+const int32 MurphysLawRelevancyGrid::RELEVANT_CELLS_RADIUS(3);		// 5x5 to 7x7 cells depending on the position in the cell
+const float MurphysLawRelevancyGrid::HEARING_DISTANCE(12000.f);		// 120 meters
+const float MurphysLawRelevancyGrid::NOISE_DURATION(2.f);
+const float MurphysLawRelevancyGrid::SHOT_AT_DURATION(3.f);
+const float MurphysLawRelevancyGrid::VIEWER_REFRESH_INTERVAL(0.25f);
+
+MurphysLawRelevancyGrid::MurphysLawRelevancyGrid()
+	: IsBuilt(false)
+{}
+
+// Buckets the characters of the world in cells
+void MurphysLawRelevancyGrid::Rebuild(UWorld* World)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ML_RelevancyGridRebuild);
+
+	// Keep the allocated arrays from one rebuild to the other
+	for (auto& Pair : Cells) Pair.Value.Reset();
+	for (auto& Pair : TeamMembers) Pair.Value.Reset();
+
+	for (TActorIterator<AMurphysLawCharacter> It(World); It; ++It)
+	{
+		Cells.FindOrAdd(GetCell(It->GetActorLocation())).Add(*It);
+
+		const int32 Team = GetTeam(*It);
+		if (Team != INDEX_NONE) TeamMembers.FindOrAdd(Team).Add(*It);
+	}
+
+	// Forget what is too old to matter
+	const float Time = World->GetTimeSeconds();
+	for (auto It = Noises.CreateIterator(); It; ++It)
+	{
+		if (Time - It.Value().Time > NOISE_DURATION) It.RemoveCurrent();
+	}
+	for (auto ViewerIt = ShotsPerViewer.CreateIterator(); ViewerIt; ++ViewerIt)
+	{
+		for (auto It = ViewerIt.Value().CreateIterator(); It; ++It)
+		{
+			if (Time - It.Value() > SHOT_AT_DURATION) It.RemoveCurrent();
+		}
+		if (ViewerIt.Value().Num() == 0) ViewerIt.RemoveCurrent();
+	}
+	for (auto It = Viewers.CreateIterator(); It; ++It)
+	{
+		// The viewer has left the game
+		if (Time - It.Value().ComputedTime > VIEWER_REFRESH_INTERVAL * 10.f) It.RemoveCurrent();
+	}
+
+	IsBuilt = true;
+}
+
+// Reports if the actor is relevant to the viewer, the relevant set of the viewer is refreshed if needed
+bool MurphysLawRelevancyGrid::IsRelevant(const AActor* Actor, const AActor* RealViewer, const FVector& ViewLocation, float Time)
+{
+	ViewerCache* Cache = Viewers.Find(RealViewer);
+	if (Cache == nullptr)
+	{
+		Cache = &Viewers.Add(RealViewer);
+		ComputeRelevantActors(*Cache, RealViewer, ViewLocation, Time);
+	}
+	else if (Time - Cache->ComputedTime >= VIEWER_REFRESH_INTERVAL)
+	{
+		ComputeRelevantActors(*Cache, RealViewer, ViewLocation, Time);
+	}
+
+	return Cache->RelevantActors.Contains(Actor);
+}
+
+// Reports if the actors have been bucketed at least once
+bool MurphysLawRelevancyGrid::HasBeenBuilt() const { return IsBuilt; }
+
+// Makes the source relevant to the viewers within hearing distance for a while
+void MurphysLawRelevancyGrid::NotifyNoise(const AActor* Source, const FVector& Location, float Time)
+{
+	Noise& SourceNoise = Noises.FindOrAdd(Source);
+	SourceNoise.Location = Location;
+	SourceNoise.Time = Time;
+}
+
+// Makes the target relevant to the viewer for a while
+void MurphysLawRelevancyGrid::NotifyShotAt(const AActor* Viewer, const AActor* Target, float Time)
+{
+	if (Viewer != nullptr && Target != nullptr)
+		ShotsPerViewer.FindOrAdd(Viewer).Add(Target, Time);
+}
+
+// Reports the grid of the game mode, null on clients
+MurphysLawRelevancyGrid* MurphysLawRelevancyGrid::Get(const UWorld* World)
+{
+	AMurphysLawGameMode* GameMode = World != nullptr ? Cast<AMurphysLawGameMode>(World->GetAuthGameMode()) : nullptr;
+	return GameMode != nullptr ? &GameMode->GetRelevancyGrid() : nullptr;
+}
+
+// Reports the cell containing the location
+FIntPoint MurphysLawRelevancyGrid::GetCell(const FVector& Location)
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CELL_SIZE), FMath::FloorToInt(Location.Y / CELL_SIZE));
+}
+
+// Reports the team of the viewer or the character, INDEX_NONE if unknown
+int32 MurphysLawRelevancyGrid::GetTeam(const AActor* Actor)
+{
+	const APlayerState* PlayerState = nullptr;
+	if (const AController* Controller = Cast<AController>(Actor))
+		PlayerState = Controller->PlayerState;
+	else if (const APawn* Pawn = Cast<APawn>(Actor))
+		PlayerState = Pawn->PlayerState;
+
+	const AMurphysLawPlayerState* MurphysLawPlayerState = Cast<AMurphysLawPlayerState>(PlayerState);
+	return MurphysLawPlayerState != nullptr ? MurphysLawPlayerState->GetTeam() : INDEX_NONE;
+}
+
+// Recomputes the relevant set of a viewer
+void MurphysLawRelevancyGrid::ComputeRelevantActors(ViewerCache& Cache, const AActor* RealViewer, const FVector& ViewLocation, float Time) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ML_RelevancyViewerRefresh);
+	INC_DWORD_STAT(STAT_ML_RelevancyViewerRefreshes);
+
+	Cache.ComputedTime = Time;
+	Cache.RelevantActors.Reset();
+
+	// The actors around the viewer
+	const FIntPoint ViewerCell = GetCell(ViewLocation);
+	for (int32 X = ViewerCell.X - RELEVANT_CELLS_RADIUS; X <= ViewerCell.X + RELEVANT_CELLS_RADIUS; ++X)
+	{
+		for (int32 Y = ViewerCell.Y - RELEVANT_CELLS_RADIUS; Y <= ViewerCell.Y + RELEVANT_CELLS_RADIUS; ++Y)
+		{
+			if (const TArray<const AActor*>* Cell = Cells.Find(FIntPoint(X, Y)))
+				Cache.RelevantActors.Append(*Cell);
+		}
+	}
+
+	// The teammates, wherever they are
+	if (const TArray<const AActor*>* Teammates = TeamMembers.Find(GetTeam(RealViewer)))
+		Cache.RelevantActors.Append(*Teammates);
+
+	// What can be heard
+	for (const auto& Pair : Noises)
+	{
+		if (FVector::DistSquared(Pair.Value.Location, ViewLocation) <= FMath::Square(HEARING_DISTANCE))
+			Cache.RelevantActors.Add(Pair.Key);
+	}
+
+	// Who shot at the viewer and who the viewer shot at
+	if (const TMap<const AActor*, float>* Shots = ShotsPerViewer.Find(RealViewer))
+	{
+		for (const auto& Pair : *Shots)
+			Cache.RelevantActors.Add(Pair.Key);
+	}
+}
@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+/**
+ * Server side uniform grid deciding which characters are relevant to a connection.
+ *
+ * The actors are bucketed in cells at a fixed rate and the relevant set of each viewer is
+ * only recomputed a few times per second, so IsNetRelevantFor becomes a set lookup instead
+ * of a distance check for every connection and every actor on every net tick.
+ *
+ * An actor is relevant to a viewer when it is in a nearby cell, when it is a teammate,
+ * when it made noise within hearing distance or when it recently shot at (or was shot by) the viewer.
+ */
+class MURPHYSLAW_API MurphysLawRelevancyGrid
+{
+	/** Size of a cell side in unreal units */
+	static const float CELL_SIZE;
+
+	/** Number of cells around the viewer's cell that are relevant */
+	static const int32 RELEVANT_CELLS_RADIUS;
+
+	/** Distance at which a noise makes its source relevant */
+	static const float HEARING_DISTANCE;
+
+	/** Number of seconds a noise keeps its source relevant */
+	static const float NOISE_DURATION;
+
+	/** Number of seconds a shooter and its target stay relevant to each other */
+	static const float SHOT_AT_DURATION;
+
+	/** Number of seconds before the relevant set of a viewer is recomputed */
+	static const float VIEWER_REFRESH_INTERVAL;
+
+	/** Noise made by an actor */
+	struct Noise
+	{
+		FVector Location;
+		float Time;
+	};
+
+	/** Relevant set of a viewer, recomputed at VIEWER_REFRESH_INTERVAL */
+	struct ViewerCache
+	{
+		float ComputedTime;
+		TSet<const AActor*> RelevantActors;
+	};
+
+	/** Indicates if the actors have been bucketed at least once */
+	bool IsBuilt;
+
+	/** The bucketed actors */
+	TMap<FIntPoint, TArray<const AActor*> > Cells;
+
+	/** The characters of each team */
+	TMap<int32, TArray<const AActor*> > TeamMembers;
+
+	/** The last noise made by each actor */
+	TMap<const AActor*, Noise> Noises;
+
+	/** The last time each actor shot at or was shot by each viewer */
+	TMap<const AActor*, TMap<const AActor*, float> > ShotsPerViewer;
+
+	/** The relevant set of each viewer */
+	TMap<const AActor*, ViewerCache> Viewers;
+
+public:
+	MurphysLawRelevancyGrid();
+
+	/** Buckets the characters of the world in cells */
+	void Rebuild(UWorld* World);
+
+	/** Reports if the actor is relevant to the viewer, the relevant set of the viewer is refreshed if needed */
+	bool IsRelevant(const AActor* Actor, const AActor* RealViewer, const FVector& ViewLocation, float Time);
+
+	/** Reports if the actors have been bucketed at least once */
+	bool HasBeenBuilt() const;
+
+	/** Makes the source relevant to the viewers within hearing distance for a while */
+	void NotifyNoise(const AActor* Source, const FVector& Location, float Time);
+
+	/** Makes the target relevant to the viewer for a while */
+	void NotifyShotAt(const AActor* Viewer, const AActor* Target, float Time);
+
+	/** Reports the grid of the game mode, null on clients */
+	static MurphysLawRelevancyGrid* Get(const UWorld* World);
+
+private:
+	/** Reports the cell containing the location */
+	static FIntPoint GetCell(const FVector& Location);
+
+	/** Reports the team of the viewer or the character, INDEX_NONE if unknown */
+	static int32 GetTeam(const AActor* Actor);
+
+	/** Recomputes the relevant set of a viewer */
+	void ComputeRelevantActors(ViewerCache& Cache, const AActor* RealViewer, const FVector& ViewLocation, float Time) const;
+};
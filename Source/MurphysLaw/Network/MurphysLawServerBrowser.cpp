@@ -0,0 +1,152 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MurphysLaw.h"
+#include "MurphysLawServerBrowser.h"
+#include "../MurphysLawGameInstance.h"
+
+DECLARE_CYCLE_STAT(TEXT("Server browser merge"), STAT_ML_ServerBrowserMerge, STATGROUP_MurphysLaw);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Server browser known sessions"), STAT_ML_ServerBrowserKnownSessions, STATGROUP_MurphysLaw);
+
+const FName MurphysLawServerBrowser::SETTING_SERVERNAME(TEXT("SERVERNAME"));
+const FName MurphysLawServerBrowser::SETTING_PLAYERCOUNT(TEXT("PLAYERCOUNT"));
+const FName MurphysLawServerBrowser::SETTING_SERVERFRAMETIME(TEXT("SERVERFRAMETIME"));
+const float MurphysLawServerBrowser::STALE_TIME(10.f);
+const float MurphysLawServerBrowser::TIME_TO_LIVE(30.f);
+const float MurphysLawServerBrowser::FULL_LOAD_FRAME_TIME(1000.f / 30.f);
+const float MurphysLawServerBrowser::FULL_LOAD_PING(200.f);
+
+MurphysLawServerBrowser::MurphysLawServerBrowser()
+	: NumMergedResults(0)
+	, NextKey(0)
+{}
+
+// Starts merging the results of a new search
+void MurphysLawServerBrowser::BeginSearch()
+{
+	NumMergedResults = 0;
+}
+
+// Merges the results of the current search not merged yet, returns true if the sessions changed
+bool MurphysLawServerBrowser::Merge(const TArray<FOnlineSessionSearchResult>& Results, float Time)
+{
+	if (NumMergedResults >= Results.Num()) return false;
+
+	SCOPE_CYCLE_COUNTER(STAT_ML_ServerBrowserMerge);
+
+	for (; NumMergedResults < Results.Num(); ++NumMergedResults)
+	{
+		const FOnlineSessionSearchResult& Result = Results[NumMergedResults];
+		if (!Result.IsValid()) continue;
+
+		// The sessions are few, finding one by its identifier is cheaper than keeping a map in sync
+		const FString Id = Result.GetSessionIdStr();
+		KnownSession* Session = Sessions.FindByPredicate([&Id](const KnownSession& Known) { return Known.Id == Id; });
+		if (Session == nullptr)
+		{
+			Session = &Sessions[Sessions.AddDefaulted()];
+			Session->Id = Id;
+			Session->Key = NextKey++;
+		}
+
+		Session->Result = Result;
+		Session->LastSeenTime = Time;
+		ReadSettings(*Session);
+	}
+
+	SET_DWORD_STAT(STAT_ML_ServerBrowserKnownSessions, Sessions.Num());
+	return true;
+}
+
+// Forgets the sessions not seen for too long, returns true if the sessions changed
+bool MurphysLawServerBrowser::Expire(float Time)
+{
+	const int32 Removed = Sessions.RemoveAll([Time](const KnownSession& Session) { return Time - Session.LastSeenTime > TIME_TO_LIVE; });
+
+	SET_DWORD_STAT(STAT_ML_ServerBrowserKnownSessions, Sessions.Num());
+	return Removed > 0;
+}
+
+// Indicates if a session has to be seen again by a new search
+bool MurphysLawServerBrowser::NeedsRefresh(float Time) const
+{
+	if (Sessions.Num() == 0) return true;
+
+	for (const KnownSession& Session : Sessions)
+	{
+		if (Time - Session.LastSeenTime > STALE_TIME) return true;
+	}
+	return false;
+}
+
+// Fills the entries of the server list with the sessions, the least loaded first
+void MurphysLawServerBrowser::GetEntries(TArray<FServerEntry>& Entries) const
+{
+	Entries.Reset();
+
+	for (const KnownSession& Session : Sessions)
+	{
+		// As before, the sessions without any player are not listed
+		if (Session.NumPlayers == 0) continue;
+
+		const FOnlineSession& Online = Session.Result.Session;
+		FString ServerName;
+		FString MapName;
+		Online.SessionSettings.Get(SETTING_SERVERNAME, ServerName);
+		Online.SessionSettings.Get(SETTING_MAPNAME, MapName);
+
+		FServerEntry& Entry = Entries[Entries.AddDefaulted()];
+		Entry.ServerName = ServerName == "" ? Online.OwningUserName : ServerName;
+		Entry.MapName = MapName;
+		Entry.GameType = "";
+		Entry.CurrentPlayers = FString::FromInt(Session.NumPlayers);
+		Entry.MaxPlayers = FString::FromInt(Session.MaxPlayers);
+		Entry.Ping = FString::FromInt(Session.Result.PingInMs);
+		Entry.SearchResultsIndex = Session.Key;
+		Entry.PingInMs = Session.Result.PingInMs;
+		Entry.ServerFrameTime = Session.ServerFrameTime;
+		Entry.Load = Session.Load;
+		Entry.IsFull = Session.NumPlayers >= Session.MaxPlayers;
+	}
+
+	Entries.Sort([](const FServerEntry& A, const FServerEntry& B) { return A.Load < B.Load; });
+}
+
+// Reports the session of an entry from its key, null if it was forgotten
+const FOnlineSessionSearchResult* MurphysLawServerBrowser::GetResult(int32 Key) const
+{
+	// The list can be shown while a search forgets sessions, the key stays the same when the array is compacted
+	const KnownSession* Session = Sessions.FindByPredicate([Key](const KnownSession& Known) { return Known.Key == Key; });
+	return Session != nullptr ? &Session->Result : nullptr;
+}
+
+// Reports the key of the least loaded session having a free slot, INDEX_NONE if there is none
+int32 MurphysLawServerBrowser::GetBestSession() const
+{
+	const KnownSession* Best = nullptr;
+	for (const KnownSession& Session : Sessions)
+	{
+		if (Session.NumPlayers == 0 || Session.NumPlayers >= Session.MaxPlayers) continue;
+
+		if (Best == nullptr || Session.Load < Best->Load)
+			Best = &Session;
+	}
+	return Best != nullptr ? Best->Key : INDEX_NONE;
+}
+
+// Reads the advertised settings of a session and computes its load
+void MurphysLawServerBrowser::ReadSettings(KnownSession& Session)
+{
+	const FOnlineSession& Online = Session.Result.Session;
+
+	Session.MaxPlayers = Online.SessionSettings.NumPublicConnections + Online.SessionSettings.NumPrivateConnections;
+
+	// The sessions hosted before the player count was advertised only report their open connections
+	if (!Online.SessionSettings.Get(SETTING_PLAYERCOUNT, Session.NumPlayers))
+		Session.NumPlayers = Session.MaxPlayers - Online.NumOpenPublicConnections - Online.NumOpenPrivateConnections;
+
+	Session.ServerFrameTime = 0.f;
+	Online.SessionSettings.Get(SETTING_SERVERFRAMETIME, Session.ServerFrameTime);
+
+	// The ping of every session is measured from the same broadcast, the load weighs it with the frame time of the server
+	Session.Load = Session.ServerFrameTime / FULL_LOAD_FRAME_TIME + Session.Result.PingInMs / FULL_LOAD_PING;
+}
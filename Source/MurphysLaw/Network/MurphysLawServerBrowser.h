@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+/**
+ * Sessions found by the searches of the server browser, kept between two searches.
+ *
+ * The results of a search are merged as they arrive, a known session is updated in place
+ * and a new one is appended, so the list never has to be emptied. The periodic refresh only searches
+ * once a session was not seen for a while, and the sessions not seen for longer are forgotten.
+ * The sessions advertise their player count and their frame time, from which they are ranked.
+ * The server list refers to a session by a key that does not change when other sessions are forgotten.
+ */
+class MURPHYSLAW_API MurphysLawServerBrowser
+{
+public:
+	/** Name of the server advertised by a session */
+	static const FName SETTING_SERVERNAME;
+
+	/** Number of players advertised by a session */
+	static const FName SETTING_PLAYERCOUNT;
+
+	/** Average frame time of the server advertised by a session, in milliseconds */
+	static const FName SETTING_SERVERFRAMETIME;
+
+private:
+	/** Number of seconds after which a session has to be seen again by a new search */
+	static const float STALE_TIME;
+
+	/** Number of seconds after which a session not seen again is forgotten */
+	static const float TIME_TO_LIVE;
+
+	/** Frame time of a server at full load, in milliseconds */
+	static const float FULL_LOAD_FRAME_TIME;
+
+	/** Ping counted as much as a server at full load, in milliseconds */
+	static const float FULL_LOAD_PING;
+
+	/** A session found by a search */
+	struct KnownSession
+	{
+		FOnlineSessionSearchResult Result;
+		FString Id;
+		int32 Key;
+		float LastSeenTime;
+		int32 NumPlayers;
+		int32 MaxPlayers;
+		float ServerFrameTime;
+		float Load;
+	};
+
+	/** The known sessions, in the order they were found */
+	TArray<KnownSession> Sessions;
+
+	/** Number of results of the current search already merged */
+	int32 NumMergedResults;
+
+	/** Key given to the next new session */
+	int32 NextKey;
+
+public:
+	MurphysLawServerBrowser();
+
+	/** Starts merging the results of a new search */
+	void BeginSearch();
+
+	/** Merges the results of the current search not merged yet, returns true if the sessions changed */
+	bool Merge(const TArray<FOnlineSessionSearchResult>& Results, float Time);
+
+	/** Forgets the sessions not seen for too long, returns true if the sessions changed */
+	bool Expire(float Time);
+
+	/** Indicates if a session has to be seen again by a new search */
+	bool NeedsRefresh(float Time) const;
+
+	/** Fills the entries of the server list with the sessions, the least loaded first */
+	void GetEntries(TArray<struct FServerEntry>& Entries) const;
+
+	/** Reports the session of an entry from its key, null if it was forgotten */
+	const FOnlineSessionSearchResult* GetResult(int32 Key) const;
+
+	/** Reports the key of the least loaded session having a free slot, INDEX_NONE if there is none */
+	int32 GetBestSession() const;
+
+private:
+	/** Reads the advertised settings of a session and computes its load */
+	static void ReadSettings(KnownSession& Session);
+};
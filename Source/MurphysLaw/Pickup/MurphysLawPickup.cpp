@@ -16,9 +16,12 @@ AMurphysLawPickup::AMurphysLawPickup()
 	SphereContact = CreateDefaultSubobject<USphereComponent>(TEXT("SphereContactComponent"));
 	SphereContact->SetSphereRadius(50.f, false);
 	RootComponent = SphereContact;
-	bReplicates = true;
 	bVisiblePickup = true;
 
+	// The pickup manager of the server checks the collections and replicates the availability of all the pickups
+	SphereContact->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	bReplicates = false;
+
 	// Set the default sounds
 	Sounds.CollectSound = nullptr;
 }
@@ -30,9 +33,6 @@ void AMurphysLawPickup::BeginPlay()
 
 	// Debug messages
 	if (Sounds.CollectSound == nullptr) ShowWarning(FString::Printf(TEXT("[%s] - Resource 'Sounds.CollectSound' is not set"), *GetName()));
-
-	// Bind event handlers
-	SphereContact->OnComponentBeginOverlap.AddDynamic(this, &AMurphysLawPickup::OnBeginOverlap);
 }
 
 // Called when game ends
@@ -40,27 +40,20 @@ void AMurphysLawPickup::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	//Clear the TimerHandle_RespawnPickup
 	GetWorldTimerManager().ClearTimer(TimerHandle_RespawnPickup);
-
-	// Remove event handlers
-	SphereContact->OnComponentBeginOverlap.RemoveDynamic(this, &AMurphysLawPickup::OnBeginOverlap);
 }
 
-// Event handler called when an actor overlaps the damage zone
-void AMurphysLawPickup::OnBeginOverlap(AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+// Gives the pickup to the character, called by the pickup manager
+void AMurphysLawPickup::Collect(AMurphysLawCharacter* Character)
 {
-	// Other Actor is the actor that triggered the event. Check that is not ourself.
-	if ((OtherActor != nullptr) && (OtherActor != this))
-	{
-		if (OtherActor != nullptr)
-		{
-			AMurphysLawCharacter* Character = Cast<AMurphysLawCharacter>(OtherActor);
-			// Interact with actor
-			if(Character)
-				ExecuteCollectorInterraction(Character);
-		}
-	}
+	ExecuteCollectorInterraction(Character);
 }
 
+// Reports the number of seconds before a collected pickup comes back
+float AMurphysLawPickup::GetRespawnTime() const { return RespawnTime; }
+
+// Reports the distance at which a character collects the pickup
+float AMurphysLawPickup::GetCollectRadius() const { return SphereContact->GetScaledSphereRadius(); }
+
 void AMurphysLawPickup::ExecuteCollectorInterraction(AMurphysLawCharacter* Character)
 {
 	SetPickupVisible(false);
@@ -75,8 +68,16 @@ void AMurphysLawPickup::SetPickupVisible(bool IsVisible)
 {
 	bVisiblePickup = IsVisible;
 	SetActorHiddenInGame(!IsVisible);
-	SetActorEnableCollision(IsVisible);
-	GetWorldTimerManager().SetTimer(TimerHandle_RespawnPickup, this, &AMurphysLawPickup::Respawn, RespawnTime, false);
+
+	if (IsVisible)
+		GetWorldTimerManager().ClearTimer(TimerHandle_RespawnPickup);
+}
+
+// Shows the pickup again after the delay, on the clients
+void AMurphysLawPickup::ScheduleRespawn(float Delay)
+{
+	if (Delay > 0.f)
+		GetWorldTimerManager().SetTimer(TimerHandle_RespawnPickup, this, &AMurphysLawPickup::Respawn, Delay, false);
 }
 
 void AMurphysLawPickup::Respawn()
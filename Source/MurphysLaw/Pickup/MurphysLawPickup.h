@@ -26,28 +26,23 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Pickup")
 	float RespawnTime;
 
-	// Code for replication
-	//UPROPERTY(Transient, ReplicatedUsing = OnRep_ActiveRepere)
+	// Indicates if the pickup is shown, its availability is replicated by the pickup manager
 	bool bVisiblePickup;
 
 	// Defines the interaction of the pickup with the actor
 	virtual void ExecuteCollectorInterraction(AMurphysLawCharacter* Character);
 
 private:
-	/** Contact sphere */
+	/** Contact sphere, only its radius is used by the pickup manager */
 	UPROPERTY(VisibleDefaultsOnly, Category = "Pickup")
 	class USphereComponent* SphereContact;
 
-	/** Handle for efficient management of RespawnPickup timer */
+	/** Handle for the local respawn of the pickup on the clients */
 	FTimerHandle TimerHandle_RespawnPickup;
 
 	/** Stores all the sounds for the weapon */
 	UPROPERTY(EditDefaultsOnly, Category = "Sound")
 	FPickupSounds Sounds;
-
-	/** Event handler when an actors enters the collision zone */
-	UFUNCTION(BlueprintCallable, Category = "Pickup")
-	void OnBeginOverlap(class AActor* OtherActor, class UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
 	
 public:	
 	// Sets default values for this actor's properties
@@ -59,7 +54,19 @@ public:
 	// Called when game ends
 	void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
+	/** Gives the pickup to the character, called by the pickup manager */
+	void Collect(AMurphysLawCharacter* Character);
+
+	/** Reports the number of seconds before a collected pickup comes back */
+	float GetRespawnTime() const;
+
+	/** Reports the distance at which a character collects the pickup */
+	float GetCollectRadius() const;
+
 	virtual void SetPickupVisible(bool IsVisible);
 
+	/** Shows the pickup again after the delay, on the clients */
+	void ScheduleRespawn(float Delay);
+
 	void Respawn();
 };
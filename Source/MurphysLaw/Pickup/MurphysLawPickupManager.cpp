@@ -0,0 +1,176 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MurphysLaw.h"
+#include "MurphysLawPickupManager.h"
+#include "MurphysLawPickup.h"
+#include "../Character/MurphysLawCharacter.h"
+#include "../Network/MurphysLawGameState.h"
+#include "../Network/MurphysLawPlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("Pickup update"), STAT_ML_PickupUpdate, STATGROUP_MurphysLaw);
+DECLARE_CYCLE_STAT(TEXT("Pickup apply states"), STAT_ML_PickupApplyStates, STATGROUP_MurphysLaw);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pickups collected"), STAT_ML_PickupsCollected, STATGROUP_MurphysLaw);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pickups"), STAT_ML_Pickups, STATGROUP_MurphysLaw);
+
+const float MurphysLawPickupManager::UPDATE_INTERVAL(0.1f);
+const float MurphysLawPickupManager::CELL_SIZE(500.f);		// 5 meters
+
+MurphysLawPickupManager::MurphysLawPickupManager()
+	: IsGathered(false)
+{}
+
+// Collects the pickups characters stand on and respawns the due ones, on the server
+void MurphysLawPickupManager::Update(UWorld* World, FMurphysLawPickupStates& States)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ML_PickupUpdate);
+
+	if (!IsGathered) GatherPickups(World);
+
+	// Every pickup is available when the match starts
+	if (States.RespawnTimes.Num() != Pickups.Num())
+	{
+		States.RespawnTimes.Init(0.f, Pickups.Num());
+		States.Availability.Init(0xFFFFFFFF, (Pickups.Num() + 31) / 32);
+	}
+
+	// Keep the allocated arrays from one update to the other
+	for (auto& Pair : CharacterCells) Pair.Value.Reset();
+	for (TActorIterator<AMurphysLawCharacter> It(World); It; ++It)
+	{
+		if (!It->IsDead()) CharacterCells.FindOrAdd(GetCell(It->GetActorLocation())).Add(*It);
+	}
+
+	const float Time = World->GetTimeSeconds();
+	for (int32 Index = 0; Index < Pickups.Num(); ++Index)
+	{
+		AMurphysLawPickup* Pickup = Pickups[Index].Get();
+		if (Pickup == nullptr) continue;
+
+		if (!IsAvailable(States, Index))
+		{
+			if (Time < States.RespawnTimes[Index]) continue;
+
+			SetAvailable(States, Index, true);
+			States.RespawnTimes[Index] = 0.f;
+			Pickup->SetPickupVisible(true);
+			continue;
+		}
+
+		AMurphysLawCharacter* Character = FindCollector(Pickup);
+		if (Character == nullptr) continue;
+
+		INC_DWORD_STAT(STAT_ML_PickupsCollected);
+
+		SetAvailable(States, Index, false);
+		States.RespawnTimes[Index] = Time + Pickup->GetRespawnTime();
+		Pickup->Collect(Character);
+
+		// The client of the player keeps its own ammunitions and weapons, it applies the pickup too
+		AMurphysLawPlayerController* Controller = Cast<AMurphysLawPlayerController>(Character->GetController());
+		if (Controller != nullptr && !Controller->IsLocalController())
+			Controller->Client_CollectPickup(Index);
+	}
+}
+
+// Shows and hides the pickups from the replicated states, on the clients
+void MurphysLawPickupManager::ApplyStates(UWorld* World, const FMurphysLawPickupStates& States, float ServerTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ML_PickupApplyStates);
+
+	if (!IsGathered) GatherPickups(World);
+
+	const int32 NumberOfPickups = FMath::Min3(Pickups.Num(), States.RespawnTimes.Num(), States.Availability.Num() * 32);
+	for (int32 Index = 0; Index < NumberOfPickups; ++Index)
+	{
+		AMurphysLawPickup* Pickup = Pickups[Index].Get();
+		if (Pickup == nullptr) continue;
+
+		// A collected pickup comes back on its own at its respawn time, the server confirms it later
+		const bool Available = IsAvailable(States, Index);
+		Pickup->SetPickupVisible(Available);
+		if (!Available) Pickup->ScheduleRespawn(States.RespawnTimes[Index] - ServerTime);
+	}
+}
+
+// Applies a pickup the server says the character collected, on its client
+void MurphysLawPickupManager::CollectOnClient(UWorld* World, int32 PickupIndex, AMurphysLawCharacter* Character)
+{
+	if (!IsGathered) GatherPickups(World);
+
+	AMurphysLawPickup* Pickup = Pickups.IsValidIndex(PickupIndex) ? Pickups[PickupIndex].Get() : nullptr;
+	if (Pickup != nullptr && Character != nullptr) Pickup->Collect(Character);
+}
+
+// Reports the manager of the game state, null until the game state exists
+MurphysLawPickupManager* MurphysLawPickupManager::Get(const UWorld* World)
+{
+	AMurphysLawGameState* GameState = World != nullptr ? World->GetGameState<AMurphysLawGameState>() : nullptr;
+	return GameState != nullptr ? &GameState->GetPickupManager() : nullptr;
+}
+
+// Finds the pickups of the level and sorts them by name
+void MurphysLawPickupManager::GatherPickups(UWorld* World)
+{
+	Pickups.Reset();
+	for (TActorIterator<AMurphysLawPickup> It(World); It; ++It)
+		Pickups.Add(*It);
+
+	Pickups.Sort([](const TWeakObjectPtr<AMurphysLawPickup>& A, const TWeakObjectPtr<AMurphysLawPickup>& B)
+	{
+		return A->GetFName() < B->GetFName();
+	});
+
+	IsGathered = true;
+	SET_DWORD_STAT(STAT_ML_Pickups, Pickups.Num());
+}
+
+// Reports the character standing on the pickup, null if none
+AMurphysLawCharacter* MurphysLawPickupManager::FindCollector(const AMurphysLawPickup* Pickup) const
+{
+	const FVector Location = Pickup->GetActorLocation();
+	const FIntPoint PickupCell = GetCell(Location);
+	const float Radius = Pickup->GetCollectRadius();
+
+	// The cells are larger than a pickup and a character, the neighbour cells are enough
+	for (int32 X = PickupCell.X - 1; X <= PickupCell.X + 1; ++X)
+	{
+		for (int32 Y = PickupCell.Y - 1; Y <= PickupCell.Y + 1; ++Y)
+		{
+			const TArray<AMurphysLawCharacter*>* Cell = CharacterCells.Find(FIntPoint(X, Y));
+			if (Cell == nullptr) continue;
+
+			for (AMurphysLawCharacter* Character : *Cell)
+			{
+				// Same as the overlap of the pickup sphere with the capsule of the character
+				const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+				const FVector Offset = Character->GetActorLocation() - Location;
+				if (Offset.SizeSquared2D() <= FMath::Square(Radius + Capsule->GetScaledCapsuleRadius())
+					&& FMath::Abs(Offset.Z) <= Radius + Capsule->GetScaledCapsuleHalfHeight())
+				{
+					return Character;
+				}
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+// Reports the cell containing the location
+FIntPoint MurphysLawPickupManager::GetCell(const FVector& Location)
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CELL_SIZE), FMath::FloorToInt(Location.Y / CELL_SIZE));
+}
+
+// Reports if the pickup can be collected
+bool MurphysLawPickupManager::IsAvailable(const FMurphysLawPickupStates& States, int32 Index)
+{
+	return (States.Availability[Index / 32] & (1u << (Index % 32))) != 0;
+}
+
+// Changes if the pickup can be collected
+void MurphysLawPickupManager::SetAvailable(FMurphysLawPickupStates& States, int32 Index, bool Available)
+{
+	if (Available) States.Availability[Index / 32] |= 1u << (Index % 32);
+	else States.Availability[Index / 32] &= ~(1u << (Index % 32));
+}
@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "MurphysLawPickupManager.generated.h"
+
+/** Replicated state of every pickup of the level, indexed as the pickups of the manager */
+USTRUCT()
+struct FMurphysLawPickupStates
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** One bit per pickup, set when the pickup can be collected */
+	UPROPERTY()
+	TArray<uint32> Availability;
+
+	/** Server time at which each collected pickup comes back, zero when it is available */
+	UPROPERTY()
+	TArray<float> RespawnTimes;
+};
+
+/**
+ * Holds all the pickups of the level in a flat array, on the server and on the clients.
+ *
+ * The pickups are neither replicated nor colliding: the server checks at a fixed rate which
+ * character stands on an available pickup, using a grid of the characters, and only replicates
+ * the availability bits and the respawn times through the game state. The clients show and hide
+ * the pickups from those, and the client who collected a pickup is told to apply it locally.
+ *
+ * The pickups are indexed by name, which is the same on the server and the clients for the
+ * pickups placed in the level.
+ */
+class MURPHYSLAW_API MurphysLawPickupManager
+{
+public:
+	/** Number of seconds between two checks of the collections and the respawns */
+	static const float UPDATE_INTERVAL;
+
+private:
+	/** Size of a cell side of the character grid in unreal units */
+	static const float CELL_SIZE;
+
+	/** The pickups of the level, sorted by name */
+	TArray<TWeakObjectPtr<class AMurphysLawPickup> > Pickups;
+
+	/** Indicates if the pickups of the level have been gathered */
+	bool IsGathered;
+
+	/** The alive characters bucketed in cells, rebuilt at each update */
+	TMap<FIntPoint, TArray<class AMurphysLawCharacter*> > CharacterCells;
+
+public:
+	MurphysLawPickupManager();
+
+	/** Collects the pickups characters stand on and respawns the due ones, on the server */
+	void Update(UWorld* World, FMurphysLawPickupStates& States);
+
+	/** Shows and hides the pickups from the replicated states, on the clients */
+	void ApplyStates(UWorld* World, const FMurphysLawPickupStates& States, float ServerTime);
+
+	/** Applies a pickup the server says the character collected, on its client */
+	void CollectOnClient(UWorld* World, int32 PickupIndex, class AMurphysLawCharacter* Character);
+
+	/** Reports the manager of the game state, null until the game state exists */
+	static MurphysLawPickupManager* Get(const UWorld* World);
+
+private:
+	/** Finds the pickups of the level and sorts them by name */
+	void GatherPickups(UWorld* World);
+
+	/** Reports the character standing on the pickup, null if none */
+	class AMurphysLawCharacter* FindCollector(const class AMurphysLawPickup* Pickup) const;
+
+	/** Reports the cell containing the location */
+	static FIntPoint GetCell(const FVector& Location);
+
+	/** Reports if the pickup can be collected */
+	static bool IsAvailable(const FMurphysLawPickupStates& States, int32 Index);
+
+	/** Changes if the pickup can be collected */
+	static void SetAvailable(FMurphysLawPickupStates& States, int32 Index, bool Available);
+};
@@ -14,31 +14,17 @@ void AMurphysLawWeaponPickup::BeginPlay()
 	// The WeaponPickup must have a weapon type set
 	checkf(WeaponType != nullptr, TEXT("No weapon type is set for this WeaponPickup"));
 
-	// Prepare the ActorSpawnParameters for all the weapons
-	FActorSpawnParameters SpawnParams;
-	SpawnParams.Owner = this;
-	SpawnParams.Instigator = Instigator;
-
 	// If the Weapon Type has been set, we spawn a weapon of that type
-	auto SpawnedWeapon = GetWorld()->SpawnActor<AMurphysLawBaseWeapon>(WeaponType, SpawnParams);
+	// The server and each client spawn their own weapon, it never moves and its visibility follows the pickup
+	const FTransform SpawnTransform(GetActorRotation(), GetActorLocation());
+	auto SpawnedWeapon = GetWorld()->SpawnActorDeferred<AMurphysLawBaseWeapon>(WeaponType, SpawnTransform, this, Instigator);
 
 	// If the weapon was spawned successfully, we store it in our inventory
 	if (SpawnedWeapon != nullptr)
 	{
+		SpawnedWeapon->SetReplicates(false);
+		SpawnedWeapon->FinishSpawning(SpawnTransform);
 		WeaponInstance = SpawnedWeapon;
-		WeaponInstance->SetActorLocation(GetActorLocation());
-
-		// When the server spawns the weapon, he starts its movement replication and repliaction in general
-		if (Role == ROLE_Authority)
-		{
-			WeaponInstance->SetReplicates(true);
-			WeaponInstance->SetReplicateMovement(true);
-		}
-		else
-		{
-			// If the client spawns the pickup, he hides it beceause the server will replicate his
-			WeaponInstance->SetActorHiddenInGame(true);
-		}
 	}
 
 	// The WeaponPickup must have a weapon instance set
@@ -66,10 +52,6 @@ void AMurphysLawWeaponPickup::SetPickupVisible(bool IsVisible)
 {
 	Super::SetPickupVisible(IsVisible);
 
-	// Only the server changes the weapon visibility as it's replicated
-	if (Role == ROLE_Authority)
-	{
-		// Change the weapon instance visibility according to the value received in parameter
-		WeaponInstance->SetActorHiddenInGame(!IsVisible);
-	}
+	// Change the weapon instance visibility according to the value received in parameter
+	WeaponInstance->SetActorHiddenInGame(!IsVisible);
 }
\ No newline at end of file
@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MurphysLaw.h"
+#include "MurphysLawAssetStreamer.h"
+#include "../MurphysLawGameInstance.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Streamed assets pinned"), STAT_ML_StreamedAssetsPinned, STATGROUP_MurphysLaw);
+
+// Lists the assets pinned by each class in the log
+static void ListStreamedAssets(UWorld* World)
+{
+	MurphysLawAssetStreamer* Streamer = MurphysLawAssetStreamer::Get(World);
+	if (Streamer != nullptr) Streamer->Report(*GLog);
+}
+
+static FAutoConsoleCommandWithWorld ListStreamedAssetsCommand(
+	TEXT("MurphysLaw.Memory.ListStreamedAssets"),
+	TEXT("Lists the assets loaded by the asset streamer for each class, with their size."),
+	FConsoleCommandWithWorldDelegate::CreateStatic(&ListStreamedAssets));
+
+MurphysLawAssetStreamer::MurphysLawAssetStreamer()
+{}
+
+// Loads the assets in the background, calls the delegate once they are all loaded
+void MurphysLawAssetStreamer::RequestAsyncLoad(const UClass* Owner, const TArray<FStringAssetReference>& Assets, FStreamableDelegate Delegate)
+{
+	Pin(Owner, Assets);
+	StreamableManager.RequestAsyncLoad(Assets, Delegate);
+}
+
+// Loads an asset right away, for the classes that cannot wait for it
+UObject* MurphysLawAssetStreamer::LoadSynchronous(const UClass* Owner, const FStringAssetReference& Asset)
+{
+	Pin(Owner, TArray<FStringAssetReference>{ Asset });
+	return StreamableManager.SynchronousLoad(Asset);
+}
+
+// Lists the assets pinned by each class, with the size of the loaded ones
+void MurphysLawAssetStreamer::Report(FOutputDevice& Ar) const
+{
+	SIZE_T TotalSize = 0;
+
+	for (const auto& Pair : PinnedAssets)
+	{
+		SIZE_T OwnerSize = 0;
+		Ar.Logf(TEXT("%s:"), *Pair.Key);
+
+		for (const FStringAssetReference& Asset : Pair.Value)
+		{
+			UObject* Object = Asset.ResolveObject();
+			const SIZE_T Size = Object != nullptr ? Object->GetResourceSize(EResourceSizeMode::Inclusive) : 0;
+			OwnerSize += Size;
+
+			Ar.Logf(TEXT("    %s  %s  %.1f KB"), *Asset.ToString(), Object != nullptr ? TEXT("loaded") : TEXT("not loaded"), Size / 1024.f);
+		}
+
+		Ar.Logf(TEXT("    %d assets, %.1f KB"), Pair.Value.Num(), OwnerSize / 1024.f);
+		TotalSize += OwnerSize;
+	}
+
+	Ar.Logf(TEXT("%d classes, %.1f KB pinned"), PinnedAssets.Num(), TotalSize / 1024.f);
+}
+
+// Reports the streamer of the game instance
+MurphysLawAssetStreamer* MurphysLawAssetStreamer::Get(const UWorld* World)
+{
+	UMurphysLawGameInstance* GameInstance = World != nullptr ? Cast<UMurphysLawGameInstance>(World->GetGameInstance()) : nullptr;
+	return GameInstance != nullptr ? &GameInstance->GetAssetStreamer() : nullptr;
+}
+
+// Records the assets requested by a class
+void MurphysLawAssetStreamer::Pin(const UClass* Owner, const TArray<FStringAssetReference>& Assets)
+{
+	TArray<FStringAssetReference>& OwnerAssets = PinnedAssets.FindOrAdd(Owner != nullptr ? Owner->GetName() : TEXT("None"));
+	for (const FStringAssetReference& Asset : Assets)
+	{
+		OwnerAssets.AddUnique(Asset);
+	}
+
+	int32 NumPinned = 0;
+	for (const auto& Pair : PinnedAssets)
+	{
+		NumPinned += Pair.Value.Num();
+	}
+	SET_DWORD_STAT(STAT_ML_StreamedAssetsPinned, NumPinned);
+}
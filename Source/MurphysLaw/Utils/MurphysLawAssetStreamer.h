@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Engine/StreamableManager.h"
+
+/**
+ * Loads the assets referenced softly by the classes of the game, once a match needs them
+ * instead of when the class defaults are constructed.
+ *
+ * The loaded assets stay pinned by the streamer, which lives as long as the game instance,
+ * and each pin is recorded with the class that asked for it. MurphysLaw.Memory.ListStreamedAssets
+ * lists the pins of each class with the size of the loaded assets.
+ */
+class MURPHYSLAW_API MurphysLawAssetStreamer
+{
+	/** Loads the assets and keeps them referenced */
+	FStreamableManager StreamableManager;
+
+	/** The assets requested by each class */
+	TMap<FString, TArray<FStringAssetReference>> PinnedAssets;
+
+public:
+	MurphysLawAssetStreamer();
+
+	/** Loads the assets in the background, calls the delegate once they are all loaded */
+	void RequestAsyncLoad(const UClass* Owner, const TArray<FStringAssetReference>& Assets, FStreamableDelegate Delegate = FStreamableDelegate());
+
+	/** Loads an asset right away, for the classes that cannot wait for it */
+	UObject* LoadSynchronous(const UClass* Owner, const FStringAssetReference& Asset);
+
+	/** Lists the assets pinned by each class, with the size of the loaded ones */
+	void Report(FOutputDevice& Ar) const;
+
+	/** Reports the streamer of the game instance */
+	static MurphysLawAssetStreamer* Get(const UWorld* World);
+
+private:
+	/** Records the assets requested by a class */
+	void Pin(const UClass* Owner, const TArray<FStringAssetReference>& Assets);
+};
@@ -103,6 +103,7 @@ bool AMurphysLawBaseWeapon::Fire(AMurphysLawCharacter* Character)
 
 		// Decrement the number of ammo left in the magazine
 		--NumberOfAmmoLeftInMagazine;
+		NotifyAmmoChanged();
 
 		return true;
 	}
@@ -178,6 +179,7 @@ void AMurphysLawBaseWeapon::Reload_Implementation()
 	
 	// Indicates the reload is done
 	IsReloading = false;
+	NotifyAmmoChanged();
 }
 
 void AMurphysLawBaseWeapon::PlayReloadSound()
@@ -200,6 +202,7 @@ int32 AMurphysLawBaseWeapon::GetNumberOfAmmoLeftInMagazine() const
 void AMurphysLawBaseWeapon::SetNumberOfAmmoLeftInMagazine(int32 NumberOfAmmo)
 {
 	NumberOfAmmoLeftInMagazine = NumberOfAmmo;
+	NotifyAmmoChanged();
 }
 
 // Reports the maximum nomber of ammo that can be carried in the inventory
@@ -218,6 +221,7 @@ int32 AMurphysLawBaseWeapon::GetNumberOfAmmoLeftInInventory() const
 void AMurphysLawBaseWeapon::SetNumberOfAmmoLeftInInventory(int32 NumberOfAmmo)
 {
 	NumberOfAmmoLeftInInventory = NumberOfAmmo;
+	NotifyAmmoChanged();
 }
 
 EWeaponTypes AMurphysLawBaseWeapon::GetWeaponType() const
@@ -233,6 +237,16 @@ void AMurphysLawBaseWeapon::AddAmmoInInventory(int32 AmountOfAmmo)
 		return;
 	}
 	NumberOfAmmoLeftInInventory = FMath::Min(GetNumberOfAmmoLeftInInventory() + AmountOfAmmo, MaximumNumberOfAmmoInInventory);
+	NotifyAmmoChanged();
+}
+
+// Lets the character holding the weapon know that its ammo changed
+void AMurphysLawBaseWeapon::NotifyAmmoChanged() const
+{
+	// The weapons of the inventory are owned by their character, the ones of the pickups are not
+	AMurphysLawCharacter* Character = Cast<AMurphysLawCharacter>(GetOwner());
+	if (Character != nullptr)
+		Character->OnWeaponAmmoChanged(this);
 }
 
 // Reports if the character can fire the weapon
@@ -209,6 +209,9 @@ protected:
 
 	bool CanFire() const;
 
+	/** Lets the character holding the weapon know that its ammo changed */
+	void NotifyAmmoChanged() const;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon")
 	TEnumAsByte<EWeaponTypes> WeaponType;
 